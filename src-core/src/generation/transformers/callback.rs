@@ -36,7 +36,7 @@ impl SwerveGenerationTransformer for CallbackSetter {
     }
 
     fn transform(&self, generator: &mut trajoptlib::SwerveTrajectoryGenerator) {
-        generator.add_callback(swerve_status_callback);
+        generator.add_callback(swerve_status_callback, 60.0);
     }
 }
 
@@ -46,6 +46,6 @@ impl DifferentialGenerationTransformer for CallbackSetter {
     }
 
     fn transform(&self, generator: &mut trajoptlib::DifferentialTrajectoryGenerator) {
-        generator.add_callback(differential_status_callback);
+        generator.add_callback(differential_status_callback, 60.0);
     }
 }
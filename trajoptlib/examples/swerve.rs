@@ -25,7 +25,10 @@ fn main() {
 
     let mut generator = SwerveTrajectoryGenerator::new();
 
-    generator.add_callback(|trajectory, handle| println!("{:?}: handle {}", trajectory, handle));
+    generator.add_callback(
+        |trajectory, handle| println!("{:?}: handle {}", trajectory, handle),
+        60.0,
+    );
     generator.set_drivetrain(&drivetrain);
     generator.set_bumpers(0.65, 0.65, 0.65, 0.65);
 
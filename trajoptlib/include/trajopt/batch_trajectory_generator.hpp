@@ -0,0 +1,118 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <expected>
+#include <variant>
+#include <vector>
+
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/differential_trajectory_generator.hpp"
+#include "trajopt/solve_options.hpp"
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Generates many trajectories in parallel.
+///
+/// Jobs are solved on a pool of worker threads. Each worker has its own queue
+/// of jobs and steals from the other workers' queues once its own is empty.
+/// Jobs are queued largest first by estimated problem size, so the longest
+/// solves start early and don't extend the total time at the end of the batch.
+///
+/// State callbacks run on the worker threads, so callbacks added to different
+/// jobs' path builders, or shared between them, may be called concurrently
+/// and must be thread-safe.
+class TRAJOPT_DLLEXPORT BatchTrajectoryGenerator {
+ public:
+  /// The result of a swerve job.
+  using SwerveResult = std::expected<SwerveSolution, slp::ExitStatus>;
+
+  /// The result of a differential job.
+  using DifferentialResult =
+      std::expected<DifferentialSolution, slp::ExitStatus>;
+
+  /// The result of a job, which matches the job's drivetrain type.
+  using Result = std::variant<SwerveResult, DifferentialResult>;
+
+  /// Construct a BatchTrajectoryGenerator.
+  ///
+  /// @param thread_count The maximum number of worker threads. Zero uses the
+  ///     number of hardware threads.
+  explicit BatchTrajectoryGenerator(size_t thread_count = 0);
+
+  /// Adds a swerve trajectory job.
+  ///
+  /// @param path_builder The path builder.
+  /// @param handle An identifier for state callbacks.
+  /// @return The job's index.
+  size_t add(SwervePathBuilder path_builder, int64_t handle = 0);
+
+  /// Adds a differential trajectory job.
+  ///
+  /// @param path_builder The path builder.
+  /// @param handle An identifier for state callbacks.
+  /// @return The job's index.
+  size_t add(DifferentialPathBuilder path_builder, int64_t handle = 0);
+
+  /// Returns the number of jobs.
+  size_t size() const { return jobs.size(); }
+
+  /// Returns the cancellation token of a job.
+  ///
+  /// Cancelling it stops that job's solve, or skips the job if it hasn't
+  /// started yet, without affecting the other jobs.
+  ///
+  /// @param job_index The job's index.
+  CancellationToken cancellation_token(size_t job_index) const {
+    return jobs[job_index].cancellation_token;
+  }
+
+  /// Generates every job's trajectory.
+  ///
+  /// This function blocks until every job has finished or been cancelled.
+  /// Cancelled jobs that never started report
+  /// slp::ExitStatus::CALLBACK_REQUESTED_STOP. If a job throws, no more jobs
+  /// are started, and the first exception is rethrown on the calling thread
+  /// once the running jobs have finished.
+  ///
+  /// @param diagnostics Enables diagnostic prints.
+  /// @return The result of each job, indexed by job index.
+  std::vector<Result> generate(bool diagnostics = false);
+
+  /// Generates every job's trajectory.
+  ///
+  /// This function blocks until every job has finished or been cancelled.
+  /// Cancelled jobs that never started report
+  /// slp::ExitStatus::CALLBACK_REQUESTED_STOP. If a job throws, no more jobs
+  /// are started, and the first exception is rethrown on the calling thread
+  /// once the running jobs have finished.
+  ///
+  /// @param options The solver options used for every job.
+  /// @return The result of each job, indexed by job index.
+  std::vector<Result> generate(const SolveOptions& options);
+
+ private:
+  struct Job {
+    std::variant<SwervePathBuilder, DifferentialPathBuilder> path_builder;
+    int64_t handle;
+    CancellationToken cancellation_token;
+
+    /// Estimated cost of solving the job, used to order jobs longest first
+    size_t cost;
+  };
+
+  /// Maximum number of worker threads
+  size_t thread_count;
+
+  /// Jobs, in the order they were added
+  std::vector<Job> jobs;
+};
+
+}  // namespace trajopt
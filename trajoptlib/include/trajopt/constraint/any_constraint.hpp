@@ -0,0 +1,292 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+
+#include "trajopt/constraint/constraint_like.hpp"
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// A user-defined constraint of any type satisfying ConstraintLike.
+///
+/// This is the Constraint variant's extension point, so team-specific
+/// constraints can be added to a path without changing the library:
+///
+/// @code{.cpp}
+/// path_builder.sgmt_constraint(0, 1, ShootOnTheMoveConstraint{...});
+/// @endcode
+///
+/// Built-in constraints keep their own variant alternatives and are dispatched
+/// with std::visit; only user constraints go through AnyConstraint's indirect
+/// call. Constraints up to buffer_size bytes are stored inline, and larger
+/// ones on the heap.
+///
+/// Two AnyConstraints compare equal if they hold the same type and that type's
+/// operator== says they're equal. Types without operator== never compare
+/// equal, so simplify_constraints() keeps every copy of them.
+class TRAJOPT_DLLEXPORT AnyConstraint {
+ public:
+  /// The size of the inline buffer in bytes.
+  static constexpr size_t buffer_size = 64;
+
+  /// Constructs an AnyConstraint holding a constraint.
+  ///
+  /// @tparam T The constraint type.
+  /// @param constraint The constraint.
+  template <typename T>
+    requires(!std::same_as<std::remove_cvref_t<T>, AnyConstraint> &&
+             ConstraintLike<std::remove_cvref_t<T>>)
+  AnyConstraint(T&& constraint)  // NOLINT
+      : m_vtable{&vtable<std::remove_cvref_t<T>>} {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (stored_inline<U>) {
+      ::new (m_buffer.data()) U(std::forward<T>(constraint));
+    } else {
+      m_heap_object = new U(std::forward<T>(constraint));
+    }
+  }
+
+  /// Copy constructor.
+  ///
+  /// @param other The AnyConstraint to copy.
+  AnyConstraint(const AnyConstraint& other) : m_vtable{other.m_vtable} {
+    if (m_vtable != nullptr) {
+      m_vtable->copy(other, *this);
+    }
+  }
+
+  /// Move constructor. The moved-from AnyConstraint is left empty.
+  ///
+  /// @param other The AnyConstraint to move.
+  AnyConstraint(AnyConstraint&& other) noexcept : m_vtable{other.m_vtable} {
+    if (m_vtable != nullptr) {
+      m_vtable->move(other, *this);
+      other.m_vtable = nullptr;
+    }
+  }
+
+  /// Copy assignment operator.
+  ///
+  /// @param other The AnyConstraint to copy.
+  AnyConstraint& operator=(const AnyConstraint& other) {
+    if (this != &other) {
+      *this = AnyConstraint{other};
+    }
+    return *this;
+  }
+
+  /// Move assignment operator. The moved-from AnyConstraint is left empty.
+  ///
+  /// @param other The AnyConstraint to move.
+  AnyConstraint& operator=(AnyConstraint&& other) noexcept {
+    if (this != &other) {
+      reset();
+      m_vtable = other.m_vtable;
+      if (m_vtable != nullptr) {
+        m_vtable->move(other, *this);
+        other.m_vtable = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  ~AnyConstraint() { reset(); }
+
+  /// Returns a pointer to the held constraint if it's a T, or nullptr
+  /// otherwise.
+  ///
+  /// @tparam T The constraint type.
+  template <typename T>
+  const T* target() const {
+    if (m_vtable == nullptr || m_vtable->type() != typeid(T)) {
+      return nullptr;
+    }
+    return static_cast<const T*>(object());
+  }
+
+  /// Calls the held constraint's prepare(), if it has one.
+  void prepare() {
+    assert(m_vtable != nullptr);
+    m_vtable->prepare(object());
+  }
+
+  /// Applies the held constraint to the given problem.
+  ///
+  /// @param problem The optimization problem.
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  void apply(slp::Problem<double>& problem, const Pose2v<double>& pose,
+             const Translation2v<double>& linear_velocity,
+             const slp::Variable<double>& angular_velocity,
+             const Translation2v<double>& linear_acceleration,
+             const slp::Variable<double>& angular_acceleration) {
+    assert(m_vtable != nullptr);
+    m_vtable->apply(object(), problem, pose, linear_velocity, angular_velocity,
+                    linear_acceleration, angular_acceleration);
+  }
+
+  /// Returns the held constraint's residual at a state, or NaN if it doesn't
+  /// have a residual() (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(const Pose2d& pose, const Translation2d& linear_velocity,
+                  double angular_velocity,
+                  const Translation2d& linear_acceleration,
+                  double angular_acceleration) const {
+    assert(m_vtable != nullptr);
+    return m_vtable->residual(object(), pose, linear_velocity,
+                              angular_velocity, linear_acceleration,
+                              angular_acceleration);
+  }
+
+  /// Returns true if both hold equal constraints of the same type.
+  ///
+  /// @param other The other AnyConstraint.
+  bool operator==(const AnyConstraint& other) const {
+    if (m_vtable == nullptr || other.m_vtable == nullptr) {
+      return m_vtable == other.m_vtable;
+    }
+    return m_vtable->type() == other.m_vtable->type() &&
+           m_vtable->equals(object(), other.object());
+  }
+
+ private:
+  /// Type-specific operations on the held constraint
+  struct VTable {
+    const std::type_info& (*type)();
+    void (*copy)(const AnyConstraint& from, AnyConstraint& to);
+    void (*move)(AnyConstraint& from, AnyConstraint& to);
+    void (*destroy)(AnyConstraint& self);
+    void (*prepare)(void* object);
+    void (*apply)(void* object, slp::Problem<double>& problem,
+                  const Pose2v<double>& pose,
+                  const Translation2v<double>& linear_velocity,
+                  const slp::Variable<double>& angular_velocity,
+                  const Translation2v<double>& linear_acceleration,
+                  const slp::Variable<double>& angular_acceleration);
+    double (*residual)(const void* object, const Pose2d& pose,
+                       const Translation2d& linear_velocity,
+                       double angular_velocity,
+                       const Translation2d& linear_acceleration,
+                       double angular_acceleration);
+    bool (*equals)(const void* lhs, const void* rhs);
+  };
+
+  alignas(std::max_align_t) std::array<std::byte, buffer_size> m_buffer;
+  void* m_heap_object = nullptr;
+  const VTable* m_vtable = nullptr;
+
+  void* object() {
+    return m_heap_object != nullptr ? m_heap_object : m_buffer.data();
+  }
+
+  const void* object() const {
+    return m_heap_object != nullptr ? m_heap_object : m_buffer.data();
+  }
+
+  void reset() {
+    if (m_vtable != nullptr) {
+      m_vtable->destroy(*this);
+      m_vtable = nullptr;
+    }
+  }
+
+  template <typename T>
+  static constexpr bool stored_inline =
+      sizeof(T) <= buffer_size && alignof(T) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<T>;
+
+  template <typename T>
+  static constexpr VTable vtable{
+      .type = []() -> const std::type_info& { return typeid(T); },
+      .copy =
+          [](const AnyConstraint& from, AnyConstraint& to) {
+            const auto& constraint = *static_cast<const T*>(from.object());
+            if constexpr (stored_inline<T>) {
+              ::new (to.m_buffer.data()) T(constraint);
+            } else {
+              to.m_heap_object = new T(constraint);
+            }
+          },
+      .move =
+          [](AnyConstraint& from, AnyConstraint& to) {
+            if constexpr (stored_inline<T>) {
+              auto& constraint = *static_cast<T*>(from.object());
+              ::new (to.m_buffer.data()) T(std::move(constraint));
+              std::destroy_at(&constraint);
+            } else {
+              to.m_heap_object = std::exchange(from.m_heap_object, nullptr);
+            }
+          },
+      .destroy =
+          [](AnyConstraint& self) {
+            if constexpr (stored_inline<T>) {
+              std::destroy_at(static_cast<T*>(self.object()));
+            } else {
+              delete static_cast<T*>(self.m_heap_object);
+              self.m_heap_object = nullptr;
+            }
+          },
+      .prepare =
+          [](void* object) {
+            if constexpr (PreparableConstraint<T>) {
+              static_cast<T*>(object)->prepare();
+            }
+          },
+      .apply =
+          [](void* object, slp::Problem<double>& problem,
+             const Pose2v<double>& pose,
+             const Translation2v<double>& linear_velocity,
+             const slp::Variable<double>& angular_velocity,
+             const Translation2v<double>& linear_acceleration,
+             const slp::Variable<double>& angular_acceleration) {
+            static_cast<T*>(object)->apply(
+                problem, pose, linear_velocity, angular_velocity,
+                linear_acceleration, angular_acceleration);
+          },
+      .residual =
+          [](const void* object, const Pose2d& pose,
+             const Translation2d& linear_velocity, double angular_velocity,
+             const Translation2d& linear_acceleration,
+             double angular_acceleration) -> double {
+            if constexpr (EvaluableConstraint<T>) {
+              return static_cast<const T*>(object)->residual(
+                  pose, linear_velocity, angular_velocity, linear_acceleration,
+                  angular_acceleration);
+            } else {
+              return NAN;
+            }
+          },
+      .equals = [](const void* lhs, const void* rhs) {
+        if constexpr (std::equality_comparable<T>) {
+          return *static_cast<const T*>(lhs) == *static_cast<const T*>(rhs);
+        } else {
+          return false;
+        }
+      }};
+};
+
+}  // namespace trajopt
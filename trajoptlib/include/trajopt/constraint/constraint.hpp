@@ -2,13 +2,20 @@
 
 #pragma once
 
-#include <concepts>
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
 #include "trajopt/constraint/angular_velocity_max_magnitude_constraint.hpp"
+#include "trajopt/constraint/any_constraint.hpp"
+#include "trajopt/constraint/constraint_like.hpp"
+#include "trajopt/constraint/keep_in_polygon_constraint.hpp"
+#include "trajopt/constraint/keep_out_polygon_constraint.hpp"
 #include "trajopt/constraint/lane_constraint.hpp"
 #include "trajopt/constraint/line_point_constraint.hpp"
 #include "trajopt/constraint/linear_acceleration_max_magnitude_constraint.hpp"
@@ -26,24 +33,13 @@
 
 namespace trajopt {
 
-/// ConstraintLike concept.
-template <typename T>
-concept ConstraintLike =
-    requires(T self, slp::Problem<double>& problem, const Pose2v<double>& pose,
-             const Translation2v<double>& linear_velocity,
-             const slp::Variable<double>& angular_velocity,
-             const Translation2v<double>& linear_acceleration,
-             const slp::Variable<double>& angular_acceleration) {
-      {
-        self.apply(problem, pose, linear_velocity, angular_velocity,
-                   linear_acceleration, angular_acceleration)
-      } -> std::same_as<void>;
-    };
-
 /// List of constraint types (must satisfy ConstraintLike concept).
 using Constraint = std::variant<
     // clang-format off
     AngularVelocityMaxMagnitudeConstraint,
+    AnyConstraint,
+    KeepInPolygonConstraint,
+    KeepOutPolygonConstraint,
     LaneConstraint,
     LinePointConstraint,
     LinearAccelerationMaxMagnitudeConstraint,
@@ -71,4 +67,116 @@ struct HoldsConstraintTypes<std::variant<Ts...>> {
 
 static_assert(HoldsConstraintTypes<Constraint>::value);
 
+/// Names of the Constraint alternatives, indexed by Constraint::index().
+inline constexpr std::array<std::string_view, std::variant_size_v<Constraint>>
+    constraint_type_names{
+        // clang-format off
+        "AngularVelocityMaxMagnitudeConstraint",
+        "AnyConstraint",
+        "KeepInPolygonConstraint",
+        "KeepOutPolygonConstraint",
+        "LaneConstraint",
+        "LinePointConstraint",
+        "LinearAccelerationMaxMagnitudeConstraint",
+        "LinearVelocityDirectionConstraint",
+        "LinearVelocityMaxMagnitudeConstraint",
+        "PointAtConstraint",
+        "PointLineConstraint",
+        "PointLineRegionConstraint",
+        "PointPointMaxConstraint",
+        "PointPointMinConstraint",
+        "PoseEqualityConstraint",
+        "TranslationEqualityConstraint"
+        // clang-format on
+    };
+
+static_assert(std::ranges::none_of(constraint_type_names,
+                                   &std::string_view::empty));
+
+/// Calls a constraint's prepare() if it has one.
+///
+/// @param constraint The constraint.
+inline void prepare_constraint(Constraint& constraint) {
+  std::visit(
+      [](auto& arg) {
+        if constexpr (PreparableConstraint<std::decay_t<decltype(arg)>>) {
+          arg.prepare();
+        }
+      },
+      constraint);
+}
+
+/// Returns a constraint's residual at a state (see EvaluableConstraint). User
+/// constraints without a residual() return NaN.
+///
+/// @param constraint The constraint.
+/// @param pose The robot's pose.
+/// @param linear_velocity The robot's linear velocity.
+/// @param angular_velocity The robot's angular velocity.
+/// @param linear_acceleration The robot's linear acceleration.
+/// @param angular_acceleration The robot's angular acceleration.
+inline double constraint_residual(const Constraint& constraint,
+                                  const Pose2d& pose,
+                                  const Translation2d& linear_velocity,
+                                  double angular_velocity,
+                                  const Translation2d& linear_acceleration,
+                                  double angular_acceleration) {
+  return std::visit(
+      [&](const auto& arg) {
+        return arg.residual(pose, linear_velocity, angular_velocity,
+                            linear_acceleration, angular_acceleration);
+      },
+      constraint);
+}
+
+/// Binds the target of a pose or translation equality constraint to parameters,
+/// so set_target_pose() also moves it in problems it was already applied to.
+/// Other constraints are unchanged.
+///
+/// @param constraint The constraint.
+inline void bind_target_parameters(Constraint& constraint) {
+  if (auto* pose = std::get_if<PoseEqualityConstraint>(&constraint)) {
+    pose->bind_parameters();
+  } else if (auto* translation =
+                 std::get_if<TranslationEqualityConstraint>(&constraint)) {
+    translation->bind_parameters();
+  }
+}
+
+/// Replaces the Parameters a built-in constraint holds with their current
+/// values, so the constraint no longer shares them with its copies. User
+/// constraints are unchanged.
+///
+/// @param constraint The constraint.
+inline void unbind_parameters(Constraint& constraint) {
+  if (auto* pose = std::get_if<PoseEqualityConstraint>(&constraint)) {
+    pose->unbind_parameters();
+  } else if (auto* translation =
+                 std::get_if<TranslationEqualityConstraint>(&constraint)) {
+    translation->unbind_parameters();
+  } else if (auto* point_at = std::get_if<PointAtConstraint>(&constraint)) {
+    point_at->unbind_parameters();
+  }
+}
+
+/// Sets the target of a pose or translation equality constraint. Translation
+/// equality constraints only use the pose's translation. Other constraints are
+/// unchanged.
+///
+/// @param constraint The constraint.
+/// @param pose The new target pose.
+/// @return True if the constraint has a target.
+inline bool set_target_pose(Constraint& constraint, const Pose2d& pose) {
+  if (auto* pose_constraint =
+          std::get_if<PoseEqualityConstraint>(&constraint)) {
+    pose_constraint->set_pose(pose);
+    return true;
+  } else if (auto* translation_constraint =
+                 std::get_if<TranslationEqualityConstraint>(&constraint)) {
+    translation_constraint->set_translation(pose.translation());
+    return true;
+  }
+  return false;
+}
+
 }  // namespace trajopt
@@ -0,0 +1,67 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <concepts>
+
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+
+namespace trajopt {
+
+/// ConstraintLike concept.
+///
+/// A constraint may also opt into a prepare() member function that precomputes
+/// the constant geometry its apply() needs (see PreparableConstraint), and a
+/// residual() member function that evaluates it at a known state (see
+/// EvaluableConstraint).
+template <typename T>
+concept ConstraintLike =
+    requires(T self, slp::Problem<double>& problem, const Pose2v<double>& pose,
+             const Translation2v<double>& linear_velocity,
+             const slp::Variable<double>& angular_velocity,
+             const Translation2v<double>& linear_acceleration,
+             const slp::Variable<double>& angular_acceleration) {
+      {
+        self.apply(problem, pose, linear_velocity, angular_velocity,
+                   linear_acceleration, angular_acceleration)
+      } -> std::same_as<void>;
+    } && (!requires(T self) { self.prepare(); } || requires(T self) {
+      { self.prepare() } -> std::same_as<void>;
+    });
+
+/// PreparableConstraint concept.
+///
+/// Generators call prepare() once per constraint before applying it to every
+/// sample it covers, so geometry that doesn't depend on the robot's state
+/// (e.g., line normals) isn't rebuilt per sample. prepare() must be idempotent,
+/// and apply() must still work if prepare() wasn't called first.
+template <typename T>
+concept PreparableConstraint = ConstraintLike<T> && requires(T self) {
+  { self.prepare() } -> std::same_as<void>;
+};
+
+/// EvaluableConstraint concept.
+///
+/// residual() evaluates the constraint at a known state, without a problem,
+/// for post-solve reports. It returns the largest violation of the
+/// constraints apply() adds, in the same form: for an inequality g(x) ≤ 0 it's
+/// g(x), which is negative when there's slack and positive when violated, and
+/// for an equality h(x) = 0 it's |h(x)|.
+template <typename T>
+concept EvaluableConstraint =
+    ConstraintLike<T> &&
+    requires(const T self, const Pose2d& pose,
+             const Translation2d& linear_velocity, double angular_velocity,
+             const Translation2d& linear_acceleration,
+             double angular_acceleration) {
+      {
+        self.residual(pose, linear_velocity, angular_velocity,
+                      linear_acceleration, angular_acceleration)
+      } -> std::same_as<double>;
+    };
+
+}  // namespace trajopt
@@ -0,0 +1,87 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <vector>
+
+#include "trajopt/geometry/translation2.hpp"
+
+namespace trajopt::detail {
+
+/// Returns the distance from a point to a line segment.
+inline double segment_point_distance(const Translation2d& segment_start,
+                                     const Translation2d& segment_end,
+                                     const Translation2d& point) {
+  Translation2d l = segment_end - segment_start;
+  Translation2d v = point - segment_start;
+
+  double squared_length = l.squared_norm();
+  double t = squared_length > 0.0
+                 ? std::clamp(v.dot(l) / squared_length, 0.0, 1.0)
+                 : 0.0;
+  return (segment_start + l * t).distance(point);
+}
+
+/// A polygon's vertices, either stored or computed on the fly (e.g., a view
+/// that transforms stored vertices into the field frame).
+template <typename T>
+concept Polygon = std::ranges::random_access_range<const T> &&
+                  std::ranges::sized_range<const T> &&
+                  std::convertible_to<std::ranges::range_value_t<const T>,
+                                      Translation2d>;
+
+/// Returns true if the projections of two polygons onto an axis are disjoint.
+template <Polygon A, Polygon B>
+bool separated_on_axis(const A& a, const B& b, const Translation2d& axis) {
+  auto [a_min, a_max] = std::ranges::minmax(
+      a | std::views::transform([&](auto&& p) { return axis.dot(p); }));
+  auto [b_min, b_max] = std::ranges::minmax(
+      b | std::views::transform([&](auto&& p) { return axis.dot(p); }));
+  return a_max < b_min || b_max < a_min;
+}
+
+/// Returns the distance between the convex hulls of two polygons, or zero if
+/// they overlap. The vertices must be in hull order (either winding).
+template <Polygon A = std::vector<Translation2d>,
+          Polygon B = std::vector<Translation2d>>
+double polygon_distance(const A& a, const B& b) {
+  // Separating axis test on a polygon's edge normals, plus the edge direction
+  // of two-point polygons so collinear segments are handled
+  auto edges_separate = [&](const auto& vertices) {
+    size_t size = std::ranges::size(vertices);
+    for (size_t i = 0; size > 1 && i < size; ++i) {
+      Translation2d edge = vertices[(i + 1) % size] - vertices[i];
+      if (separated_on_axis(a, b, {-edge.y(), edge.x()}) ||
+          (size == 2 && separated_on_axis(a, b, edge))) {
+        return true;
+      }
+    }
+    return false;
+  };
+  if (!edges_separate(a) && !edges_separate(b) &&
+      (std::ranges::size(a) > 1 || std::ranges::size(b) > 1)) {
+    return 0.0;
+  }
+
+  auto edge_distance = [](const auto& vertices, const auto& others) {
+    size_t size = std::ranges::size(vertices);
+    double distance = INFINITY;
+    for (size_t i = 0; i < size; ++i) {
+      Translation2d start = vertices[i];
+      Translation2d end = vertices[(i + 1) % size];
+      for (const Translation2d& point : others) {
+        distance =
+            std::min(distance, segment_point_distance(start, end, point));
+      }
+    }
+    return distance;
+  };
+  return std::min(edge_distance(a, b), edge_distance(b, a));
+}
+
+}  // namespace trajopt::detail
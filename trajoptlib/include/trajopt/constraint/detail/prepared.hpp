@@ -0,0 +1,24 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <optional>
+
+namespace trajopt::detail {
+
+/// Geometry a constraint derives from its parameters in prepare().
+///
+/// It's ignored by equality comparisons, so a prepared constraint still
+/// compares equal to an unprepared copy of itself.
+///
+/// @tparam T The derived geometry type.
+template <typename T>
+struct Prepared {
+  /// The derived geometry, or empty if prepare() hasn't been called.
+  std::optional<T> value;
+
+  /// Returns true; derived geometry never makes constraints differ.
+  bool operator==(const Prepared&) const { return true; }
+};
+
+}  // namespace trajopt::detail
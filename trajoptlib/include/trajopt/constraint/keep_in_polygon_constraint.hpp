@@ -0,0 +1,179 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Keep-in polygon constraint.
+///
+/// Specifies that a set of points on the robot (e.g., its center and bumper
+/// corners) must stay inside a convex polygon on the field.
+///
+/// The constructor precomputes each edge's unit normal and offset, and drops
+/// constraints that are provably redundant: degenerate and collinear edges,
+/// which bound the same half-plane as another edge, and robot points inside
+/// the convex hull of the others, which stay inside the polygon whenever the
+/// hull's vertices do. Each sample then gets one constraint per remaining
+/// edge and hull vertex.
+class TRAJOPT_DLLEXPORT KeepInPolygonConstraint {
+ public:
+  /// Constructs a KeepInPolygonConstraint.
+  ///
+  /// @param field_polygon Vertices of the convex field polygon, wound either
+  ///     clockwise or counterclockwise.
+  /// @param robot_points Points in the robot's frame that must stay inside the
+  ///     polygon. Must be nonempty.
+  explicit KeepInPolygonConstraint(
+      const std::vector<Translation2d>& field_polygon,
+      std::vector<Translation2d> robot_points = {{0.0, 0.0}})
+      : m_robot_points{convex_hull(std::move(robot_points))} {
+    assert(!m_robot_points.empty());
+
+    // Flip the normals of clockwise polygons so they point inward
+    double signed_area = 0.0;
+    for (size_t i = 0; i < field_polygon.size(); ++i) {
+      signed_area += field_polygon[i].cross(
+          field_polygon[(i + 1) % field_polygon.size()]);
+    }
+    double winding = signed_area < 0.0 ? -1.0 : 1.0;
+
+    for (size_t i = 0; i < field_polygon.size(); ++i) {
+      const auto& start = field_polygon[i];
+      const auto& end = field_polygon[(i + 1) % field_polygon.size()];
+
+      auto edge = end - start;
+      double length = edge.norm();
+      if (length == 0.0) {
+        continue;
+      }
+
+      Translation2d normal{-edge.y() / length * winding,
+                           edge.x() / length * winding};
+      double offset = normal.dot(start);
+      bool redundant = std::ranges::any_of(
+          std::views::iota(size_t{0}, m_normals.size()), [&](size_t j) {
+            return std::abs(m_normals[j].dot(normal) - 1.0) < 1e-9 &&
+                   std::abs(m_offsets[j] - offset) < 1e-9;
+          });
+      if (!redundant) {
+        m_normals.push_back(normal);
+        m_offsets.push_back(offset);
+      }
+    }
+  }
+
+  /// Returns the robot points that are constrained, which are the vertices of
+  /// the given robot points' convex hull.
+  const std::vector<Translation2d>& robot_points() const {
+    return m_robot_points;
+  }
+
+  /// Returns the number of polygon edges that are constrained.
+  size_t edge_count() const { return m_normals.size(); }
+
+  /// Applies this constraint to the given problem.
+  ///
+  /// @param problem The optimization problem.
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  void apply(
+      slp::Problem<double>& problem, const Pose2v<double>& pose,
+      [[maybe_unused]] const Translation2v<double>& linear_velocity,
+      [[maybe_unused]] const slp::Variable<double>& angular_velocity,
+      [[maybe_unused]] const Translation2v<double>& linear_acceleration,
+      [[maybe_unused]] const slp::Variable<double>& angular_acceleration) {
+    for (const auto& robot_point : m_robot_points) {
+      auto point = pose.translation() + robot_point.rotate_by(pose.rotation());
+      for (size_t i = 0; i < m_normals.size(); ++i) {
+        problem.subject_to(m_normals[i].dot(point) >= m_offsets[i]);
+      }
+    }
+  }
+
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    double residual = -INFINITY;
+    for (const auto& robot_point : m_robot_points) {
+      auto point = pose.translation() + robot_point.rotate_by(pose.rotation());
+      for (size_t i = 0; i < m_normals.size(); ++i) {
+        residual = std::max(residual, m_offsets[i] - m_normals[i].dot(point));
+      }
+    }
+    return residual;
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const KeepInPolygonConstraint& other) const = default;
+
+ private:
+  std::vector<Translation2d> m_robot_points;
+  std::vector<Translation2d> m_normals;
+  std::vector<double> m_offsets;
+
+  /// Returns the vertices of a point set's convex hull in counterclockwise
+  /// order, without duplicate or collinear points.
+  static std::vector<Translation2d> convex_hull(
+      std::vector<Translation2d> points) {
+    std::ranges::sort(points, [](const auto& a, const auto& b) {
+      return std::pair{a.x(), a.y()} < std::pair{b.x(), b.y()};
+    });
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.size() < 3) {
+      return points;
+    }
+
+    // Andrew's monotone chain. The upper hull continues from the lower hull's
+    // last point, and its own last point is the lower hull's first.
+    std::vector<Translation2d> hull;
+    auto add_point = [&](const Translation2d& point, size_t chain_start) {
+      while (hull.size() >= chain_start + 2 &&
+             (hull.back() - hull[hull.size() - 2]).cross(point - hull.back()) <=
+                 0.0) {
+        hull.pop_back();
+      }
+      hull.push_back(point);
+    };
+    for (const auto& point : points) {
+      add_point(point, 0);
+    }
+    size_t upper_start = hull.size() - 1;
+    for (const auto& point :
+         points | std::views::reverse | std::views::drop(1)) {
+      add_point(point, upper_start);
+    }
+    hull.pop_back();
+
+    return hull;
+  }
+};
+
+}  // namespace trajopt
@@ -0,0 +1,166 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+
+#include "trajopt/constraint/detail/polygon_distance.hpp"
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Keep-out polygon constraint.
+///
+/// Specifies the required minimum distance between a polygon on the robot's
+/// frame (e.g., its bumpers) and a polygon on the field. A circular obstacle
+/// is a one-point field polygon with its radius as the minimum distance.
+///
+/// Both polygons are treated as their convex hulls. Each sample gets a
+/// separating axis as auxiliary decision variables: the robot's vertices must
+/// lie at least the minimum distance beyond a line that the field's vertices
+/// lie behind. That's one constraint per vertex instead of one per pair of
+/// robot and field features.
+class TRAJOPT_DLLEXPORT KeepOutPolygonConstraint {
+ public:
+  /// Constructs a KeepOutPolygonConstraint.
+  ///
+  /// @param robot_polygon Vertices of the robot polygon in the robot's frame.
+  ///     Must be nonempty.
+  /// @param field_polygon Vertices of the field polygon. Must be nonempty.
+  /// @param min_distance Minimum distance between the polygons. Must be
+  ///     nonnegative.
+  explicit KeepOutPolygonConstraint(std::vector<Translation2d> robot_polygon,
+                                    std::vector<Translation2d> field_polygon,
+                                    double min_distance)
+      : m_robot_polygon{std::move(robot_polygon)},
+        m_field_polygon{std::move(field_polygon)},
+        m_min_distance{min_distance} {
+    assert(!m_robot_polygon.empty());
+    assert(!m_field_polygon.empty());
+    assert(m_min_distance >= 0.0);
+  }
+
+  /// Returns the minimum distance between the polygons.
+  double min_distance() const { return m_min_distance; }
+
+  /// Returns the distance between the polygons with the robot at a pose, or
+  /// zero if they overlap.
+  ///
+  /// @param pose The robot's pose.
+  double distance(const Pose2d& pose) const {
+    // Transform the robot's vertices lazily, since this runs on every sample
+    // while lazy keep-outs check which to activate
+    auto robot_polygon =
+        m_robot_polygon | std::views::transform([&](const auto& robot_point) {
+          return pose.translation() + robot_point.rotate_by(pose.rotation());
+        });
+    return detail::polygon_distance(robot_polygon, m_field_polygon);
+  }
+
+  /// Applies this constraint to the given problem.
+  ///
+  /// @param problem The optimization problem.
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  void apply(
+      slp::Problem<double>& problem, const Pose2v<double>& pose,
+      [[maybe_unused]] const Translation2v<double>& linear_velocity,
+      [[maybe_unused]] const slp::Variable<double>& angular_velocity,
+      [[maybe_unused]] const Translation2v<double>& linear_acceleration,
+      [[maybe_unused]] const slp::Variable<double>& angular_acceleration) {
+    // The separating line is n·p = c with a normal n pointing toward the
+    // robot. It's seeded from the initial guess so the solver starts on the
+    // correct side of the obstacle.
+    auto [n_guess, c_guess] = guess_separating_axis(pose);
+    auto n_x = problem.decision_variable();
+    auto n_y = problem.decision_variable();
+    auto c = problem.decision_variable();
+    n_x.set_value(n_guess.x());
+    n_y.set_value(n_guess.y());
+    c.set_value(c_guess);
+    Translation2v<double> n{n_x, n_y};
+
+    // With a positive minimum distance, ‖n‖ ≤ 1 is convex unlike ‖n‖ = 1, and
+    // still conservative: the robot's vertices clear the line by at least the
+    // minimum distance over ‖n‖, and n = 0 is infeasible. A zero minimum
+    // distance needs the equality to rule out n = 0, c = 0.
+    if (m_min_distance > 0.0) {
+      problem.subject_to(n.squared_norm() <= 1.0);
+    } else {
+      problem.subject_to(n.squared_norm() == 1.0);
+    }
+    for (const auto& field_point : m_field_polygon) {
+      problem.subject_to(n.dot(field_point) <= c);
+    }
+    for (const auto& robot_point : m_robot_polygon) {
+      auto point = pose.translation() + robot_point.rotate_by(pose.rotation());
+      problem.subject_to(n.dot(point) >= c + m_min_distance);
+    }
+  }
+
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    // The separating axis is an auxiliary variable with no value outside a
+    // problem, so this is the shortfall of the clearance instead
+    return m_min_distance - distance(pose);
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const KeepOutPolygonConstraint& other) const = default;
+
+ private:
+  std::vector<Translation2d> m_robot_polygon;
+  std::vector<Translation2d> m_field_polygon;
+  double m_min_distance;
+
+  /// Returns a separating axis normal and offset from the direction of the
+  /// field polygon's centroid to the robot's current position.
+  std::pair<Translation2d, double> guess_separating_axis(
+      const Pose2v<double>& pose) const {
+    Translation2d centroid{0.0, 0.0};
+    for (const auto& field_point : m_field_polygon) {
+      centroid = centroid + field_point;
+    }
+    centroid = centroid / static_cast<double>(m_field_polygon.size());
+
+    slp::Variable x = pose.x();
+    slp::Variable y = pose.y();
+    Translation2d direction{x.value() - centroid.x(),
+                            y.value() - centroid.y()};
+    double norm = direction.norm();
+    direction = norm > 0.0 ? direction / norm : Translation2d{1.0, 0.0};
+
+    double max_projection = -INFINITY;
+    for (const auto& field_point : m_field_polygon) {
+      max_projection = std::max(max_projection, direction.dot(field_point));
+    }
+
+    return {direction, max_projection};
+  }
+};
+
+}  // namespace trajopt
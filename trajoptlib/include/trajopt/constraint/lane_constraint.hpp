@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <optional>
 
@@ -59,6 +60,14 @@ class TRAJOPT_DLLEXPORT LaneConstraint {
           }
         }()} {}
 
+  /// Precomputes both lines' geometry.
+  void prepare() {
+    m_top_line.prepare();
+    if (m_bottom_line.has_value()) {
+      m_bottom_line.value().prepare();
+    }
+  }
+
   /// Applies this constraint to the given problem.
   ///
   /// @param problem The optimization problem.
@@ -81,6 +90,32 @@ class TRAJOPT_DLLEXPORT LaneConstraint {
     }
   }
 
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(const Pose2d& pose, const Translation2d& linear_velocity,
+                  double angular_velocity,
+                  const Translation2d& linear_acceleration,
+                  double angular_acceleration) const {
+    double residual =
+        m_top_line.residual(pose, linear_velocity, angular_velocity,
+                            linear_acceleration, angular_acceleration);
+    if (m_bottom_line.has_value()) {
+      residual = std::max(residual, m_bottom_line.value().residual(
+                                        pose, linear_velocity,
+                                        angular_velocity, linear_acceleration,
+                                        angular_acceleration));
+    }
+    return residual;
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const LaneConstraint& other) const = default;
+
  private:
   PointLineRegionConstraint m_top_line;
   std::optional<PointLineRegionConstraint> m_bottom_line;
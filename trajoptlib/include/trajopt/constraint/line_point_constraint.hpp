@@ -8,7 +8,8 @@
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
-#include "trajopt/constraint/detail/line_point_squared_distance.hpp"
+#include "trajopt/constraint/detail/polygon_distance.hpp"
+#include "trajopt/constraint/detail/prepared.hpp"
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
 #include "trajopt/util/symbol_exports.hpp"
@@ -38,6 +39,18 @@ class TRAJOPT_DLLEXPORT LinePointConstraint {
     assert(min_distance >= 0.0);
   }
 
+  /// Precomputes the robot line's direction and squared length, which don't
+  /// change as the line rotates with the robot.
+  void prepare() {
+    if (m_geometry.value) {
+      return;
+    }
+
+    auto direction = m_robot_line_end - m_robot_line_start;
+    m_geometry.value = Geometry{.direction = direction,
+                                .squared_length = direction.squared_norm()};
+  }
+
   /// Applies this constraint to the given problem.
   ///
   /// @param problem The optimization problem.
@@ -52,20 +65,67 @@ class TRAJOPT_DLLEXPORT LinePointConstraint {
       [[maybe_unused]] const slp::Variable<double>& angular_velocity,
       [[maybe_unused]] const Translation2v<double>& linear_acceleration,
       [[maybe_unused]] const slp::Variable<double>& angular_acceleration) {
+    prepare();
+    const auto& geometry = *m_geometry.value;
+
+    auto line_start =
+        pose.translation() + m_robot_line_start.rotate_by(pose.rotation());
+    if (geometry.squared_length == 0.0) {
+      problem.subject_to((m_field_point - line_start).squared_norm() >=
+                         m_min_distance * m_min_distance);
+      return;
+    }
+
+    // Same as detail::line_point_squared_distance(), but the line's squared
+    // length is a constant instead of an expression of the rotated line
+    auto line = geometry.direction.rotate_by(pose.rotation());
+    auto t = (m_field_point - line_start).dot(line) / geometry.squared_length;
+    auto t_bounded = slp::max(slp::min(t, 1), 0);
+    auto closest_point = line_start + line * t_bounded;
+    problem.subject_to((closest_point - m_field_point).squared_norm() >=
+                       m_min_distance * m_min_distance);
+  }
+
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
     auto line_start =
         pose.translation() + m_robot_line_start.rotate_by(pose.rotation());
     auto line_end =
         pose.translation() + m_robot_line_end.rotate_by(pose.rotation());
-    auto squared_distance = detail::line_point_squared_distance(
-        line_start, line_end, m_field_point);
-    problem.subject_to(squared_distance >= m_min_distance * m_min_distance);
+    double distance =
+        detail::segment_point_distance(line_start, line_end, m_field_point);
+    return m_min_distance * m_min_distance - distance * distance;
   }
 
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const LinePointConstraint& other) const = default;
+
  private:
+  /// Robot line geometry derived by prepare()
+  struct Geometry {
+    /// The robot line's end minus its start in the robot's frame
+    Translation2d direction;
+
+    /// The robot line's squared length
+    double squared_length;
+  };
+
   Translation2d m_robot_line_start;
   Translation2d m_robot_line_end;
   Translation2d m_field_point;
   double m_min_distance;
+  detail::Prepared<Geometry> m_geometry;
 };
 
 }  // namespace trajopt
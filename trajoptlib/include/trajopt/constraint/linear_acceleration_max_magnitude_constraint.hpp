@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
@@ -25,6 +27,9 @@ class TRAJOPT_DLLEXPORT LinearAccelerationMaxMagnitudeConstraint {
     assert(max_magnitude >= 0.0);
   }
 
+  /// Returns the maximum magnitude.
+  double max_magnitude() const { return m_max_magnitude; }
+
   /// Applies this constraint to the given problem.
   ///
   /// @param problem The optimization problem.
@@ -49,6 +54,31 @@ class TRAJOPT_DLLEXPORT LinearAccelerationMaxMagnitudeConstraint {
     }
   }
 
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      [[maybe_unused]] const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    if (m_max_magnitude == 0.0) {
+      return std::max(std::abs(linear_acceleration.x()),
+                      std::abs(linear_acceleration.y()));
+    }
+    return linear_acceleration.squared_norm() -
+           m_max_magnitude * m_max_magnitude;
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const LinearAccelerationMaxMagnitudeConstraint& other) const =
+      default;
+
  private:
   double m_max_magnitude;
 };
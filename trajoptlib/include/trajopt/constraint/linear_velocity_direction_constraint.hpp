@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cmath>
+
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
@@ -43,6 +45,28 @@ class TRAJOPT_DLLEXPORT LinearVelocityDirectionConstraint {
     problem.subject_to(dot * dot == linear_velocity.squared_norm());
   }
 
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      [[maybe_unused]] const Pose2d& pose,
+      const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    double dot =
+        linear_velocity.dot(Translation2d{m_angle.cos(), m_angle.sin()});
+    return std::abs(dot * dot - linear_velocity.squared_norm());
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const LinearVelocityDirectionConstraint& other) const =
+      default;
+
  private:
   trajopt::Rotation2d m_angle;
 };
@@ -3,13 +3,16 @@
 #pragma once
 
 #include <cassert>
+#include <cmath>
 #include <utility>
+#include <variant>
 
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/parameter.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -34,6 +37,49 @@ class TRAJOPT_DLLEXPORT PointAtConstraint {
     assert(m_heading_tolerance >= 0.0);
   }
 
+  /// Constructs a PointAtConstraint whose field point can be changed after
+  /// it's applied, by setting the parameter's value.
+  ///
+  /// @param field_point Field point.
+  /// @param heading_tolerance The allowed robot heading tolerance (radians).
+  ///     Must be nonnegative.
+  /// @param flip False points at the field point while true points away from
+  ///     the field point.
+  explicit PointAtConstraint(TranslationParameter field_point,
+                             double heading_tolerance, bool flip = false)
+      : m_field_point{std::move(field_point)},
+        m_heading_tolerance{heading_tolerance},
+        m_flip{flip} {
+    assert(m_heading_tolerance >= 0.0);
+  }
+
+  /// Returns the field point's current value.
+  Translation2d field_point() const {
+    if (const auto* parameter =
+            std::get_if<TranslationParameter>(&m_field_point)) {
+      return parameter->value();
+    }
+    return std::get<Translation2d>(m_field_point);
+  }
+
+  /// Replaces the field point's TranslationParameter with its current value,
+  /// so this copy no longer shares it. Does nothing if it's not bound.
+  void unbind_parameters() { m_field_point = field_point(); }
+
+  /// Returns true if both constraints always point at the same field point:
+  /// equal constant points, or the same parameter.
+  ///
+  /// @param other The other constraint.
+  bool has_same_field_point(const PointAtConstraint& other) const {
+    return m_field_point == other.m_field_point;
+  }
+
+  /// Returns the allowed robot heading tolerance (radians).
+  double heading_tolerance() const { return m_heading_tolerance; }
+
+  /// Returns true if the robot points away from the field point.
+  bool flip() const { return m_flip; }
+
   /// Applies this constraint to the given problem.
   ///
   /// @param problem The optimization problem.
@@ -55,8 +101,16 @@ class TRAJOPT_DLLEXPORT PointAtConstraint {
     //
     // constrain dot to cos(1.0), which is colinear
     // and cos(theta_tolerance)
-    auto dx = m_field_point.x() - pose.x();
-    auto dy = m_field_point.y() - pose.y();
+    Translation2v<double> field_point;
+    if (const auto* parameter =
+            std::get_if<TranslationParameter>(&m_field_point)) {
+      field_point = parameter->variable();
+    } else {
+      const auto& constant = std::get<Translation2d>(m_field_point);
+      field_point = {constant.x(), constant.y()};
+    }
+    auto dx = field_point.x() - pose.x();
+    auto dy = field_point.y() - pose.y();
     auto dot = pose.rotation().cos() * dx + pose.rotation().sin() * dy;
     if (!m_flip) {
       // dot close to 1 * hypot (point toward)
@@ -69,8 +123,32 @@ class TRAJOPT_DLLEXPORT PointAtConstraint {
     }
   }
 
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    auto target = field_point();
+    double dx = target.x() - pose.x();
+    double dy = target.y() - pose.y();
+    double dot = pose.rotation().cos() * dx + pose.rotation().sin() * dy;
+    double bound = std::cos(m_heading_tolerance) * std::hypot(dx, dy);
+    return m_flip ? dot + bound : bound - dot;
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const PointAtConstraint& other) const = default;
+
  private:
-  Translation2d m_field_point;
+  std::variant<Translation2d, TranslationParameter> m_field_point;
   double m_heading_tolerance;
   bool m_flip;
 };
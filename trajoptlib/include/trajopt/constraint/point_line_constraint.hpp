@@ -9,6 +9,7 @@
 #include <sleipnir/optimization/problem.hpp>
 
 #include "trajopt/constraint/detail/line_point_squared_distance.hpp"
+#include "trajopt/constraint/detail/polygon_distance.hpp"
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
 #include "trajopt/util/symbol_exports.hpp"
@@ -59,6 +60,28 @@ class TRAJOPT_DLLEXPORT PointLineConstraint {
     problem.subject_to(squared_distance >= m_min_distance * m_min_distance);
   }
 
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    auto point = pose.translation() + m_robot_point.rotate_by(pose.rotation());
+    double distance = detail::segment_point_distance(m_field_line_start,
+                                                     m_field_line_end, point);
+    return m_min_distance * m_min_distance - distance * distance;
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const PointLineConstraint& other) const = default;
+
  private:
   Translation2d m_robot_point;
   Translation2d m_field_line_start;
@@ -4,11 +4,13 @@
 
 #include <stdint.h>
 
+#include <cmath>
 #include <utility>
 
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
+#include "trajopt/constraint/detail/prepared.hpp"
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
 #include "trajopt/util/symbol_exports.hpp"
@@ -45,6 +47,16 @@ class TRAJOPT_DLLEXPORT PointLineRegionConstraint {
         m_field_line_end{std::move(field_line_end)},
         m_side{side} {}
 
+  /// Precomputes the field line's normal and offset, so apply() only builds
+  /// the expressions that depend on the robot's pose.
+  void prepare() {
+    if (m_geometry.value) {
+      return;
+    }
+
+    m_geometry.value = make_geometry();
+  }
+
   /// Applies this constraint to the given problem.
   ///
   /// @param problem The optimization problem.
@@ -59,8 +71,80 @@ class TRAJOPT_DLLEXPORT PointLineRegionConstraint {
       [[maybe_unused]] const slp::Variable<double>& angular_velocity,
       [[maybe_unused]] const Translation2v<double>& linear_acceleration,
       [[maybe_unused]] const slp::Variable<double>& angular_acceleration) {
+    prepare();
+    const auto& geometry = *m_geometry.value;
+
+    auto point = geometry.robot_point_is_origin
+                     ? pose.translation()
+                     : pose.translation() +
+                           m_robot_point.rotate_by(pose.rotation());
+    auto cross = geometry.normal.dot(point) - geometry.offset;
+
+    switch (m_side) {
+      case Side::ABOVE:
+        problem.subject_to(cross > 0);
+        break;
+      case Side::BELOW:
+        problem.subject_to(cross < 0);
+        break;
+      case Side::ON:
+        problem.subject_to(cross == 0);
+        break;
+    }
+  }
+
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    auto geometry = m_geometry.value ? *m_geometry.value : make_geometry();
     auto point = pose.translation() + m_robot_point.rotate_by(pose.rotation());
+    double cross = geometry.normal.dot(point) - geometry.offset;
+
+    switch (m_side) {
+      case Side::ABOVE:
+        return -cross;
+      case Side::BELOW:
+        return cross;
+      case Side::ON:
+        break;
+    }
+    return std::abs(cross);
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const PointLineRegionConstraint& other) const = default;
+
+ private:
+  /// Field line geometry derived by prepare()
+  struct Geometry {
+    /// The field line's left normal, scaled by its length
+    Translation2d normal;
+
+    /// The normal's dot product with the field line start
+    double offset;
+
+    /// Whether the robot point is the robot's origin, so it needn't be rotated
+    bool robot_point_is_origin;
+  };
+
+  Translation2d m_robot_point;
+  Translation2d m_field_line_start;
+  Translation2d m_field_line_end;
+  Side m_side;
+  detail::Prepared<Geometry> m_geometry;
 
+  /// Computes the field line geometry.
+  Geometry make_geometry() const {
     // Determine which side of the start-end field line a point is on.
     //
     // The cross product a x b = |a|₂|b|₂sinθ for a and b vectors with the same
@@ -85,28 +169,15 @@ class TRAJOPT_DLLEXPORT PointLineRegionConstraint {
     //   cross > 0 means point is left of line (above)
     //   cross = 0 means point is on line
     //   cross < 0 means point is right of line (below)
+    //
+    // a x b = a_x b_y - a_y b_x = (-a_y, a_x) · b, so the cross product is
+    // n · point - n · start for the constant normal n = (-a_y, a_x).
     auto line = m_field_line_end - m_field_line_start;
-    auto start_to_point = point - m_field_line_start;
-    auto cross = line.cross(start_to_point);
-
-    switch (m_side) {
-      case Side::ABOVE:
-        problem.subject_to(cross > 0);
-        break;
-      case Side::BELOW:
-        problem.subject_to(cross < 0);
-        break;
-      case Side::ON:
-        problem.subject_to(cross == 0);
-        break;
-    }
+    Translation2d normal{-line.y(), line.x()};
+    return Geometry{.normal = normal,
+                    .offset = normal.dot(m_field_line_start),
+                    .robot_point_is_origin = m_robot_point == Translation2d{}};
   }
-
- private:
-  Translation2d m_robot_point;
-  Translation2d m_field_line_start;
-  Translation2d m_field_line_end;
-  Side m_side;
 };
 
 }  // namespace trajopt
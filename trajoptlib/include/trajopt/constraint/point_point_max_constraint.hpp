@@ -56,6 +56,28 @@ class TRAJOPT_DLLEXPORT PointPointMaxConstraint {
     problem.subject_to(dx * dx + dy * dy <= m_max_distance * m_max_distance);
   }
 
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    auto bumper_corner =
+        pose.translation() + m_robot_point.rotate_by(pose.rotation());
+    return (m_field_point - bumper_corner).squared_norm() -
+           m_max_distance * m_max_distance;
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const PointPointMaxConstraint& other) const = default;
+
  private:
   Translation2d m_robot_point;
   Translation2d m_field_point;
@@ -2,11 +2,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <variant>
+
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/parameter.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -20,7 +26,46 @@ class TRAJOPT_DLLEXPORT PoseEqualityConstraint {
   /// @param y The robot's y position.
   /// @param heading The robot's heading.
   PoseEqualityConstraint(double x, double y, double heading)
-      : m_pose{x, y, heading} {}
+      : m_pose{Pose2d{x, y, heading}} {}
+
+  /// Constructs a PoseEqualityConstraint whose target pose can be changed
+  /// after it's applied, by setting the parameter's value.
+  ///
+  /// @param pose The robot's pose.
+  explicit PoseEqualityConstraint(PoseParameter pose)
+      : m_pose{std::move(pose)} {}
+
+  /// Returns the robot's target pose.
+  Pose2d pose() const {
+    if (const auto* parameter = std::get_if<PoseParameter>(&m_pose)) {
+      return parameter->value();
+    }
+    return std::get<Pose2d>(m_pose);
+  }
+
+  /// Binds the target pose to a new PoseParameter, so set_pose() also moves it
+  /// in problems this constraint was already applied to. Does nothing if it's
+  /// already bound.
+  void bind_parameters() {
+    if (const auto* target = std::get_if<Pose2d>(&m_pose)) {
+      m_pose = PoseParameter{*target};
+    }
+  }
+
+  /// Replaces the target pose's PoseParameter with its current value, so this
+  /// copy no longer shares it. Does nothing if it's not bound.
+  void unbind_parameters() { m_pose = pose(); }
+
+  /// Sets the robot's target pose.
+  ///
+  /// @param pose The robot's pose.
+  void set_pose(const Pose2d& pose) {
+    if (auto* parameter = std::get_if<PoseParameter>(&m_pose)) {
+      parameter->set_value(pose);
+    } else {
+      m_pose = pose;
+    }
+  }
 
   /// Applies this constraint to the given problem.
   ///
@@ -36,11 +81,38 @@ class TRAJOPT_DLLEXPORT PoseEqualityConstraint {
       [[maybe_unused]] const slp::Variable<double>& angular_velocity,
       [[maybe_unused]] const Translation2v<double>& linear_acceleration,
       [[maybe_unused]] const slp::Variable<double>& angular_acceleration) {
-    problem.subject_to(pose == m_pose);
+    if (const auto* parameter = std::get_if<PoseParameter>(&m_pose)) {
+      problem.subject_to(pose == parameter->variable());
+    } else {
+      problem.subject_to(pose == std::get<Pose2d>(m_pose));
+    }
   }
 
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    auto target = this->pose();
+    return std::max(
+        {std::abs(pose.x() - target.x()), std::abs(pose.y() - target.y()),
+         std::abs(pose.rotation().cos() * target.rotation().sin() -
+                  pose.rotation().sin() * target.rotation().cos())});
+  }
+
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const PoseEqualityConstraint& other) const = default;
+
  private:
-  trajopt::Pose2d m_pose;
+  std::variant<Pose2d, PoseParameter> m_pose;
 };
 
 }  // namespace trajopt
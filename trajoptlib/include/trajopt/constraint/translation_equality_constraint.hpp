@@ -2,11 +2,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <variant>
+
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/parameter.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -18,7 +24,48 @@ class TRAJOPT_DLLEXPORT TranslationEqualityConstraint {
   ///
   /// @param x The robot's x position.
   /// @param y The robot's y position.
-  TranslationEqualityConstraint(double x, double y) : m_translation{x, y} {}
+  TranslationEqualityConstraint(double x, double y)
+      : m_translation{Translation2d{x, y}} {}
+
+  /// Constructs a TranslationEqualityConstraint whose target translation can
+  /// be changed after it's applied, by setting the parameter's value.
+  ///
+  /// @param translation The robot's translation.
+  explicit TranslationEqualityConstraint(TranslationParameter translation)
+      : m_translation{std::move(translation)} {}
+
+  /// Returns the robot's target translation.
+  Translation2d translation() const {
+    if (const auto* parameter =
+            std::get_if<TranslationParameter>(&m_translation)) {
+      return parameter->value();
+    }
+    return std::get<Translation2d>(m_translation);
+  }
+
+  /// Binds the target translation to a new TranslationParameter, so
+  /// set_translation() also moves it in problems this constraint was already
+  /// applied to. Does nothing if it's already bound.
+  void bind_parameters() {
+    if (const auto* target = std::get_if<Translation2d>(&m_translation)) {
+      m_translation = TranslationParameter{*target};
+    }
+  }
+
+  /// Replaces the target translation's TranslationParameter with its current
+  /// value, so this copy no longer shares it. Does nothing if it's not bound.
+  void unbind_parameters() { m_translation = translation(); }
+
+  /// Sets the robot's target translation.
+  ///
+  /// @param translation The robot's translation.
+  void set_translation(const Translation2d& translation) {
+    if (auto* parameter = std::get_if<TranslationParameter>(&m_translation)) {
+      parameter->set_value(translation);
+    } else {
+      m_translation = translation;
+    }
+  }
 
   /// Applies this constraint to the given problem.
   ///
@@ -34,11 +81,38 @@ class TRAJOPT_DLLEXPORT TranslationEqualityConstraint {
       [[maybe_unused]] const slp::Variable<double>& angular_velocity,
       [[maybe_unused]] const Translation2v<double>& linear_acceleration,
       [[maybe_unused]] const slp::Variable<double>& angular_acceleration) {
-    problem.subject_to(pose.translation() == m_translation);
+    if (const auto* parameter =
+            std::get_if<TranslationParameter>(&m_translation)) {
+      problem.subject_to(pose.translation() == parameter->variable());
+    } else {
+      problem.subject_to(pose.translation() ==
+                         std::get<Translation2d>(m_translation));
+    }
+  }
+
+  /// Returns this constraint's residual at a state (see EvaluableConstraint).
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  double residual(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    auto target = translation();
+    return std::max(std::abs(pose.x() - target.x()),
+                    std::abs(pose.y() - target.y()));
   }
 
+  /// Returns true if both constraints restrict the robot identically.
+  bool operator==(const TranslationEqualityConstraint& other) const = default;
+
  private:
-  trajopt::Translation2d m_translation;
+  std::variant<Translation2d, TranslationParameter> m_translation;
 };
 
 }  // namespace trajopt
@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 
+#include <chrono>
 #include <functional>
 #include <vector>
 
@@ -21,6 +22,34 @@ struct TRAJOPT_DLLEXPORT Waypoint {
   std::vector<Constraint> segment_constraints;
 };
 
+/// A callback to be called with the intermediate solution and a
+/// user-specified handle while the solver runs.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+template <typename Solution>
+struct TRAJOPT_DLLEXPORT PathCallback {
+  /// The function to call.
+  std::function<void(const Solution& solution, int64_t handle)> function;
+
+  /// The maximum rate at which the function is called (Hz). Infinity calls it
+  /// on every solver iteration, and zero disables it.
+  double max_rate = 60.0;
+
+  /// Returns true if the function should be called again.
+  ///
+  /// @param now The current time.
+  /// @param last_call_time The time the function was last called by this
+  ///     generator.
+  bool is_due(std::chrono::steady_clock::time_point now,
+              std::chrono::steady_clock::time_point last_call_time) const {
+    if (max_rate <= 0.0) {
+      return false;
+    }
+    return now - last_call_time >=
+           std::chrono::duration<double>{1.0 / max_rate};
+  }
+};
+
 /// A path.
 ///
 /// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
@@ -34,9 +63,8 @@ struct TRAJOPT_DLLEXPORT Path {
   Drivetrain drivetrain;
 
   /// A vector of callbacks to be called with the intermediate solution and a
-  /// user-specified handle at every iteration of the solver.
-  std::vector<std::function<void(const Solution& solution, int64_t handle)>>
-      callbacks;
+  /// user-specified handle during solving, each at up to its own rate.
+  std::vector<PathCallback<Solution>> callbacks;
 };
 
 }  // namespace trajopt
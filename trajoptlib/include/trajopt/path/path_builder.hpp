@@ -12,6 +12,7 @@
 #include "trajopt/constraint/constraint.hpp"
 #include "trajopt/geometry/translation2.hpp"
 #include "trajopt/path/path.hpp"
+#include "trajopt/transcription_method.hpp"
 #include "trajopt/util/generate_linear_initial_guess.hpp"
 #include "trajopt/util/generate_spline_initial_guess.hpp"
 #include "trajopt/util/symbol_exports.hpp"
@@ -65,6 +66,21 @@ class TRAJOPT_DLLEXPORT PathBuilder {
   /// @return a list of bumpers applied to the builder.
   std::vector<KeepOutRegion>& get_bumpers() { return bumpers; }
 
+  /// Returns a constraint that keeps the robot's center and every bumper
+  /// corner inside a convex field polygon.
+  ///
+  /// @param field_polygon Vertices of the convex field polygon, wound either
+  ///     clockwise or counterclockwise.
+  KeepInPolygonConstraint keep_in_polygon(
+      const std::vector<Translation2d>& field_polygon) const {
+    std::vector<Translation2d> robot_points{{0.0, 0.0}};
+    for (const auto& bumper : bumpers) {
+      robot_points.insert(robot_points.end(), bumper.points.begin(),
+                          bumper.points.end());
+    }
+    return KeepInPolygonConstraint{field_polygon, std::move(robot_points)};
+  }
+
   /// If using a discrete algorithm, specify the number of discrete
   /// samples for every segment of the trajectory
   ///
@@ -81,6 +97,57 @@ class TRAJOPT_DLLEXPORT PathBuilder {
     return control_interval_counts;
   }
 
+  /// Set how the equations of motion are enforced between samples.
+  ///
+  /// @param method The transcription method.
+  void set_transcription_method(TranscriptionMethod method) {
+    transcription_method = method;
+  }
+
+  /// Get how the equations of motion are enforced between samples.
+  TranscriptionMethod get_transcription_method() const {
+    return transcription_method;
+  }
+
+  /// Set whether accelerations are substituted from the wheel forces instead
+  /// of being decision variables.
+  ///
+  /// The reduced formulation drops the acceleration variables and the
+  /// equalities tying them to the net force and torque at every sample (three
+  /// of each per sample for swerve, two for differential), which shrinks the
+  /// problem the solver factorizes each iteration.
+  ///
+  /// @param eliminate Whether to eliminate the accelerations.
+  void set_eliminate_accelerations(bool eliminate) {
+    eliminate_accelerations = eliminate;
+  }
+
+  /// Get whether accelerations are substituted from the wheel forces instead
+  /// of being decision variables.
+  bool get_eliminate_accelerations() const { return eliminate_accelerations; }
+
+  /// Set whether each segment has one time step variable shared by all of its
+  /// samples instead of one per sample.
+  ///
+  /// The shared formulation drops the per-sample time step variables and the
+  /// equalities chaining them together within each segment. The solution
+  /// still has one time step per sample.
+  ///
+  /// @param share Whether to share one time step per segment.
+  void set_share_segment_dt(bool share) { share_segment_dt = share; }
+
+  /// Get whether each segment has one time step variable shared by all of its
+  /// samples instead of one per sample.
+  bool get_share_segment_dt() const { return share_segment_dt; }
+
+  /// Get the initial guess points of each waypoint, preceded by the segment
+  /// initial guess points leading up to it.
+  ///
+  /// @return the initial guess points
+  const std::vector<std::vector<Pose2d>>& get_initial_guess_points() const {
+    return initial_guess_points;
+  }
+
   /// Provide a guess of the instantaneous pose of the robot at a waypoint.
   ///
   /// @param wpt_index the waypoint to apply the guess to
@@ -166,15 +233,20 @@ class TRAJOPT_DLLEXPORT PathBuilder {
 
   /// Add a callback to retrieve the state of the solver as a Solution.
   ///
-  /// This callback will run on every iteration of the solver.
+  /// This callback will run on solver iterations at up to the given rate. Each
+  /// generator tracks the rate separately, so concurrent solves don't suppress
+  /// each other's callbacks.
   ///
   /// @param callback A callback whose first parameter is the Solution based on
   ///     the solver's state at that iteration, and second parameter is the
   ///     handle passed into Generate().
+  /// @param max_rate The maximum rate at which the callback is called (Hz).
+  ///     Infinity calls it on every iteration, and zero disables it.
   void add_callback(
       const std::function<void(const Solution& solution, int64_t handle)>
-          callback) {
-    path.callbacks.push_back(callback);
+          callback,
+      double max_rate = 60.0) {
+    path.callbacks.push_back({callback, max_rate});
   }
 
   /// Get the DifferentialPath being constructed
@@ -182,6 +254,47 @@ class TRAJOPT_DLLEXPORT PathBuilder {
   /// @return the path
   Path<Drivetrain, Solution>& get_path() { return path; }
 
+  /// Get the DifferentialPath being constructed
+  ///
+  /// @return the path
+  const Path<Drivetrain, Solution>& get_path() const { return path; }
+
+  /// Returns a path builder for the part of this path between two waypoints.
+  ///
+  /// The sub-path keeps the drivetrain, bumpers, callbacks, transcription
+  /// method, acceleration elimination, time step sharing, and every constraint
+  /// and initial guess point of its waypoints and segments.
+  ///
+  /// @param from_index index of the sub-path's first waypoint
+  /// @param to_index index of the sub-path's last waypoint
+  /// @return the sub-path's builder
+  PathBuilder sub_path(size_t from_index, size_t to_index) const {
+    assert(from_index < to_index && to_index < path.waypoints.size());
+
+    PathBuilder sub_builder;
+    sub_builder.path.drivetrain = path.drivetrain;
+    sub_builder.path.callbacks = path.callbacks;
+    sub_builder.path.waypoints.assign(path.waypoints.begin() + from_index,
+                                      path.waypoints.begin() + to_index + 1);
+    sub_builder.bumpers = bumpers;
+    sub_builder.initial_guess_points.assign(
+        initial_guess_points.begin() + from_index,
+        initial_guess_points.begin() + to_index + 1);
+    sub_builder.control_interval_counts.assign(
+        control_interval_counts.begin() + from_index,
+        control_interval_counts.begin() + to_index);
+    sub_builder.transcription_method = transcription_method;
+    sub_builder.eliminate_accelerations = eliminate_accelerations;
+    sub_builder.share_segment_dt = share_segment_dt;
+
+    // The first waypoint's segment belongs to the previous sub-path
+    sub_builder.path.waypoints.front().segment_constraints.clear();
+    sub_builder.initial_guess_points.front() = {
+        initial_guess_points.at(from_index).back()};
+
+    return sub_builder;
+  }
+
   /// Calculate a discrete, linear initial guess of the x, y, and heading of the
   /// robot that goes through each segment.
   ///
@@ -213,6 +326,15 @@ class TRAJOPT_DLLEXPORT PathBuilder {
   /// The control interval counts.
   std::vector<size_t> control_interval_counts;
 
+  /// The transcription method.
+  TranscriptionMethod transcription_method = TranscriptionMethod::DEFAULT;
+
+  /// Whether accelerations are substituted from the wheel forces.
+  bool eliminate_accelerations = false;
+
+  /// Whether each segment shares one time step variable.
+  bool share_segment_dt = false;
+
   /// Add new waypoints up to and including the given index.
   ///
   /// @param final_index The final index.
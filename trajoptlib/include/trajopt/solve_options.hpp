@@ -0,0 +1,71 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <vector>
+
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Options for solving a trajectory optimization problem.
+struct TRAJOPT_DLLEXPORT SolveOptions {
+  /// The solver's stopping tolerance. The default of 1e-4 is 0.1 mm.
+  double tolerance = 1e-4;
+
+  /// The maximum number of solver iterations before the solve stops.
+  int max_iterations = 5000;
+
+  /// The maximum wall-clock time before the solve stops.
+  std::chrono::duration<double> timeout{
+      std::numeric_limits<double>::infinity()};
+
+  /// If true, a solve that hits the iteration or time limit returns the
+  /// solver's last iterate instead of an error. That's wherever the solver
+  /// stopped, not the most feasible iterate it visited, and it may violate
+  /// constraints, so this is meant for previews rather than final
+  /// trajectories.
+  bool return_last_iterate_on_limit = false;
+
+  /// Fractions of each segment's control intervals to solve with before the
+  /// full problem, coarsest first (e.g., {0.25, 0.5}).
+  ///
+  /// Each level's solution is resampled as the initial guess of the next, and
+  /// the last is resampled as the initial guess of the full problem. Coarse
+  /// levels are cheap, so they settle the path's shape before the expensive
+  /// full resolution solve. State callbacks only run for the full problem, and
+  /// the timeout covers every level.
+  std::vector<double> coarse_to_fine_levels;
+
+  /// If true, a swerve path is split at its intermediate waypoints that pin
+  /// the robot's pose and stop it, and the independent sub-paths are solved in
+  /// parallel and joined. The joined solution matches solving the whole path,
+  /// and becomes the generator's current iterate like a whole-path solution.
+  /// State callbacks don't run for the sub-paths. Differential paths, and
+  /// swerve paths transcribed with TranscriptionMethod::TRAPEZOIDAL or
+  /// TranscriptionMethod::HERMITE_SIMPSON, are always solved whole; the latter
+  /// two's interval before a stop uses the stop's acceleration. So are paths
+  /// with user constraints (see AnyConstraint), which may hold Parameters the
+  /// sub-paths can't be given their own copies of. The sub-paths use the
+  /// current values of built-in constraints' Parameters.
+  bool split_at_stops = false;
+
+  /// If true, keep-out constraints start out applied only at samples whose
+  /// initial guess is within keep_out_activation_distance of violating them.
+  /// After each solve, the constraints the solution violates are applied and
+  /// the problem is re-solved from that solution until none are violated.
+  /// Each solve gets the full iteration limit, and the timeout covers every
+  /// solve.
+  bool lazy_keep_outs = false;
+
+  /// With lazy_keep_outs, the extra clearance (m) within which a keep-out
+  /// constraint is applied before the first solve.
+  double keep_out_activation_distance = 0.5;
+
+  /// Enables diagnostic prints.
+  bool diagnostics = false;
+};
+
+}  // namespace trajopt
@@ -3,6 +3,9 @@
 #pragma once
 
 #include <array>
+#include <cassert>
+#include <cmath>
+#include <span>
 #include <utility>
 
 #include "trajopt/geometry/pose2.hpp"
@@ -85,6 +88,56 @@ class TRAJOPT_DLLEXPORT CubicHermitePoseSplineHolonomic : CubicHermiteSpline {
     }
   }
 
+  /// Gets the pose at each point t on the spline in one pass.
+  ///
+  /// Unlike get_point(), this skips the curvature and writes each component
+  /// into its own array, so the loops over t have no branches or temporaries
+  /// and can be vectorized. Where a differential drive's course is undefined,
+  /// its heading is zero.
+  ///
+  /// @param t The points t.
+  /// @param is_differential Whether the drivetrain is a differential drive.
+  /// @param x The x coordinate at each point t.
+  /// @param y The y coordinate at each point t.
+  /// @param heading_cos The cosine of the heading at each point t.
+  /// @param heading_sin The sine of the heading at each point t.
+  void get_poses(std::span<const double> t, bool is_differential,
+                 std::span<double> x, std::span<double> y,
+                 std::span<double> heading_cos,
+                 std::span<double> heading_sin) const {
+    assert(x.size() == t.size() && y.size() == t.size() &&
+           heading_cos.size() == t.size() && heading_sin.size() == t.size());
+
+    // Rows 0 and 1 hold the position coefficients and rows 2 and 3 the
+    // velocity coefficients, from the highest power of t down
+    const auto& c = coefficients();
+
+    for (size_t i = 0; i < t.size(); ++i) {
+      x[i] = ((c(0, 0) * t[i] + c(0, 1)) * t[i] + c(0, 2)) * t[i] + c(0, 3);
+      y[i] = ((c(1, 0) * t[i] + c(1, 1)) * t[i] + c(1, 2)) * t[i] + c(1, 3);
+    }
+
+    if (is_differential) {
+      // The heading is the course, the direction of the velocity
+      for (size_t i = 0; i < t.size(); ++i) {
+        double dx = (c(2, 0) * t[i] + c(2, 1)) * t[i] + c(2, 2);
+        double dy = (c(3, 0) * t[i] + c(3, 1)) * t[i] + c(3, 2);
+        double magnitude = std::hypot(dx, dy);
+        bool defined = magnitude > 1e-6;
+        heading_cos[i] = defined ? dx / magnitude : 1.0;
+        heading_sin[i] = defined ? dy / magnitude : 0.0;
+      }
+    } else {
+      for (size_t i = 0; i < t.size(); ++i) {
+        double dθ = theta.get_position(t[i]);
+        double cos_dθ = std::cos(dθ);
+        double sin_dθ = std::sin(dθ);
+        heading_cos[i] = r0.cos() * cos_dθ - r0.sin() * sin_dθ;
+        heading_sin[i] = r0.sin() * cos_dθ + r0.cos() * sin_dθ;
+      }
+    }
+  }
+
  private:
   Rotation2d r0;
   CubicHermiteSpline1d theta;
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <expected>
 #include <utility>
 #include <vector>
@@ -10,8 +11,15 @@
 #include <sleipnir/optimization/problem.hpp>
 #include <sleipnir/optimization/solver/exit_status.hpp>
 
+#include "trajopt/constraint/constraint.hpp"
 #include "trajopt/geometry/translation2.hpp"
 #include "trajopt/path/path_builder.hpp"
+#include "trajopt/solve_options.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/constraint_report.hpp"
+#include "trajopt/util/parameter.hpp"
+#include "trajopt/util/sample_matrix.hpp"
+#include "trajopt/util/segment_layout.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -77,11 +85,11 @@ struct TRAJOPT_DLLEXPORT SwerveSolution {
   /// The angular accelerations.
   std::vector<double> alpha;
 
-  /// The x forces for each module.
-  std::vector<std::vector<double>> module_fx;
+  /// The x forces for each module, indexed by sample then module.
+  SampleMatrix<double> module_fx;
 
-  /// The y forces for each module.
-  std::vector<std::vector<double>> module_fy;
+  /// The y forces for each module, indexed by sample then module.
+  SampleMatrix<double> module_fy;
 };
 
 /// Swerve trajectory sample.
@@ -184,7 +192,10 @@ class TRAJOPT_DLLEXPORT SwerveTrajectory {
           std::atan2(solution.thetasin[sample], solution.thetacos[sample]),
           solution.vx[sample], solution.vy[sample], solution.omega[sample],
           solution.ax[sample], solution.ay[sample], solution.alpha[sample],
-          solution.module_fx[sample], solution.module_fy[sample]);
+          std::vector<double>(solution.module_fx[sample].begin(),
+                              solution.module_fx[sample].end()),
+          std::vector<double>(solution.module_fy[sample].begin(),
+                              solution.module_fy[sample].end()));
       ts += solution.dt[sample];
     }
   }
@@ -206,8 +217,11 @@ class TRAJOPT_DLLEXPORT SwerveTrajectoryGenerator {
   ///
   /// @param path_builder The path builder.
   /// @param handle An identifier for state callbacks.
+  /// @param cancellation_token A token checked on each solver iteration, which
+  ///     can be cancelled from another thread to stop generate() early.
   explicit SwerveTrajectoryGenerator(SwervePathBuilder path_builder,
-                                     int64_t handle = 0);
+                                     int64_t handle = 0,
+                                     CancellationToken cancellation_token = {});
 
   /// Generates an optimal trajectory.
   ///
@@ -219,11 +233,87 @@ class TRAJOPT_DLLEXPORT SwerveTrajectoryGenerator {
   std::expected<SwerveSolution, slp::ExitStatus> generate(
       bool diagnostics = false);
 
+  /// Generates an optimal trajectory.
+  ///
+  /// This function may take a long time to complete.
+  ///
+  /// @param options The solver options.
+  /// @return Returns a holonomic trajectory on success, or the solver's exit
+  ///     status on failure.
+  std::expected<SwerveSolution, slp::ExitStatus> generate(
+      const SolveOptions& options);
+
+  /// Generates an optimal trajectory, warm started from a previous solution.
+  ///
+  /// Every decision variable, including the input forces and the time steps,
+  /// is seeded from the given solution instead of the path's initial guess,
+  /// so re-solving a slightly modified path converges in a few iterations. If
+  /// the solution's sample count doesn't match this problem's, it's ignored
+  /// and the path's initial guess is used instead; use resample_solution() to
+  /// map a solution onto new control interval counts first.
+  ///
+  /// @param warm_start A previous solution of a path with the same control
+  ///     interval counts.
+  /// @param options The solver options.
+  /// @return Returns a holonomic trajectory on success, or the solver's exit
+  ///     status on failure.
+  std::expected<SwerveSolution, slp::ExitStatus> generate(
+      const SwerveSolution& warm_start, const SolveOptions& options = {});
+
+  /// Solves the problem again from the current iterate, which is the last
+  /// solution after a successful generate().
+  ///
+  /// This keeps the problem alive rather than rebuilding it: the decision
+  /// variables, constraints and expression graphs the constructor built are
+  /// reused as is. Change the values of the Parameters its constraints were
+  /// built with first (see Parameter), and the re-solve converges in a few
+  /// iterations from the previous solution. Only problem construction is
+  /// saved; the solver still recomputes the Jacobian and Hessian sparsity and
+  /// the KKT system's symbolic analysis on every solve.
+  /// SolveOptions::split_at_stops and SolveOptions::coarse_to_fine_levels are
+  /// ignored, since both would build new problems.
+  ///
+  /// @param options The solver options.
+  /// @return Returns a holonomic trajectory on success, or the solver's exit
+  ///     status on failure.
+  std::expected<SwerveSolution, slp::ExitStatus> resolve(
+      const SolveOptions& options = {});
+
+  /// Moves a waypoint's pose or translation target without rebuilding the
+  /// problem. Call resolve() afterward to solve from the previous solution.
+  ///
+  /// Translation waypoints only use the pose's translation. The waypoint's
+  /// sample in the current iterate is moved onto the new target too. Does
+  /// nothing for waypoints without a target.
+  ///
+  /// @param wpt_index The waypoint index.
+  /// @param pose The new target pose.
+  void set_waypoint_pose(size_t wpt_index, const Pose2d& pose);
+
+  /// Evaluates every path constraint at every sample of the current iterate,
+  /// which is the last solution after generate(), and reports each one's
+  /// residual, whether it's active, and how long applying each constraint type
+  /// took while building the problem.
+  ///
+  /// The rows cover the path builder's constraints as given, including ones
+  /// left out of the problem because other constraints imply them.
+  ///
+  /// @param active_tolerance How close to zero an inequality's residual must
+  ///     be for it to count as active.
+  ConstraintReport constraint_report(double active_tolerance = 1e-6);
+
  private:
+  /// Path builder, kept for building coarse levels of the problem
+  SwervePathBuilder path_builder;
+
+  /// Identifier for state callbacks
+  int64_t handle;
+
   /// Swerve path
   SwervePath path;
 
-  /// State Variables
+  /// State Variables. With eliminated accelerations, ax, ay, and α are
+  /// expressions of the module forces instead.
   std::vector<slp::Variable<double>> x;
   std::vector<slp::Variable<double>> y;
   std::vector<slp::Variable<double>> cosθ;
@@ -236,19 +326,58 @@ class TRAJOPT_DLLEXPORT SwerveTrajectoryGenerator {
   std::vector<slp::Variable<double>> α;
 
   /// Input Variables
-  std::vector<std::vector<slp::Variable<double>>> Fx;
-  std::vector<std::vector<slp::Variable<double>>> Fy;
+  SampleMatrix<slp::Variable<double>> Fx;
+  SampleMatrix<slp::Variable<double>> Fy;
 
   /// Time Variables
   std::vector<slp::Variable<double>> dts;
 
   /// Discretization Constants
-  std::vector<size_t> Ns;
+  SegmentLayout layout;
+
+  /// Time each path callback was last called
+  std::vector<std::chrono::steady_clock::time_point> callback_times;
+
+  /// Solution passed to path callbacks, reused across iterations so live
+  /// previews don't allocate
+  SwerveSolution snapshot;
+
+  /// Cancellation token checked on each solver iteration
+  CancellationToken cancellation_token;
+
+  /// Keep-out constraints not applied to the problem yet, with their sample
+  /// indices
+  std::vector<std::pair<size_t, Constraint>> inactive_keep_outs;
+
+  /// Time spent applying constraints, per constraint type
+  ConstraintTiming constraint_timing;
+
+  /// Number of constraints simplify_constraints() removed from the path
+  size_t removed_constraint_count = 0;
 
   slp::Problem<double> problem;
 
+  std::expected<SwerveSolution, slp::ExitStatus> solve(
+      const SolveOptions& options);
+
+  std::expected<SwerveSolution, slp::ExitStatus> solve_split(
+      const std::vector<size_t>& split_wpts, const SolveOptions& options);
+
+  void apply_constraint(size_t index, Constraint& constraint);
+
+  /// Applies the inactive keep-out constraints whose clearance at the current
+  /// iterate is less than their minimum distance plus the given distance.
+  ///
+  /// @return The number of constraints applied.
+  size_t activate_keep_outs(double activation_distance);
+
   void apply_initial_guess(const SwerveSolution& solution);
 
+  void apply_warm_start(const SwerveSolution& solution);
+
+  /// Copies the current decision variable values into the snapshot.
+  const SwerveSolution& update_snapshot();
+
   SwerveSolution construct_swerve_solution();
 };
 
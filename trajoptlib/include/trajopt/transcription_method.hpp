@@ -0,0 +1,30 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+namespace trajopt {
+
+/// How the drivetrain's equations of motion are enforced between consecutive
+/// samples.
+///
+/// Lower order schemes build and solve faster but need more control intervals
+/// for the same accuracy, so they suit previews with few intervals; higher
+/// order schemes suit final trajectories.
+enum class TranscriptionMethod : uint8_t {
+  /// The drivetrain's own scheme: constant acceleration over each interval for
+  /// swerve, and Hermite-Simpson collocation for differential.
+  DEFAULT,
+  /// Explicit Euler: each interval integrates the derivatives at its start.
+  /// First order.
+  EXPLICIT_EULER,
+  /// Trapezoidal: each interval integrates the mean of the derivatives at its
+  /// ends. Second order.
+  TRAPEZOIDAL,
+  /// Hermite-Simpson: each interval integrates a cubic through its ends with
+  /// Simpson's rule, with the inputs interpolated linearly. Fourth order.
+  HERMITE_SIMPSON,
+};
+
+}  // namespace trajopt
@@ -2,12 +2,56 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <atomic>
+#include <memory>
 
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
 
-TRAJOPT_DLLEXPORT std::atomic<int>& get_cancellation_flag();
+/// A request to stop a trajectory generation early.
+///
+/// Copies of a token share the same state, so a caller can keep a copy and
+/// cancel a generator running on another thread. Each generator checks its
+/// own token on every solver iteration, so cancelling one generation doesn't
+/// affect others running in parallel.
+class TRAJOPT_DLLEXPORT CancellationToken {
+ public:
+  /// Constructs a CancellationToken that hasn't been cancelled.
+  CancellationToken();
+
+  /// Requests cancellation of every generation using this token.
+  void cancel();
+
+  /// Clears a previous cancellation, including one from cancel_all(), so the
+  /// token can be reused.
+  void reset();
+
+  /// Returns true if cancel() was called, or if cancel_all() was called since
+  /// this token was constructed or last reset.
+  bool is_cancelled() const;
+
+  /// Returns true if both tokens share the same state.
+  ///
+  /// @param other The other token.
+  bool operator==(const CancellationToken& other) const {
+    return m_state == other.m_state;
+  }
+
+ private:
+  struct State {
+    std::atomic<bool> cancelled{false};
+    std::atomic<uint64_t> epoch;
+  };
+
+  std::shared_ptr<State> m_state;
+};
+
+/// Cancels every CancellationToken that exists at the time of the call.
+///
+/// Tokens constructed or reset afterward aren't affected.
+TRAJOPT_DLLEXPORT void cancel_all();
 
 }  // namespace trajopt
@@ -0,0 +1,111 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "trajopt/path/path_builder.hpp"
+#include "trajopt/solve_options.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/resample_solution.hpp"
+#include "trajopt/util/segment_layout.hpp"
+
+namespace trajopt {
+
+/// Returns the control interval counts of a coarse level of a path.
+///
+/// Each nonempty segment keeps at least one control interval per initial guess
+/// point so the initial guess can still be generated.
+///
+/// @param path_builder The path builder.
+/// @param fraction The fraction of each segment's control intervals to keep.
+template <typename Drivetrain, typename Solution>
+inline std::vector<size_t> coarse_control_interval_counts(
+    const PathBuilder<Drivetrain, Solution>& path_builder, double fraction) {
+  const auto& counts = path_builder.get_control_interval_counts();
+  const auto& guess_points = path_builder.get_initial_guess_points();
+
+  std::vector<size_t> coarse_counts;
+  coarse_counts.reserve(counts.size());
+  for (size_t sgmt_index = 0; sgmt_index < counts.size(); ++sgmt_index) {
+    size_t N_sgmt = counts[sgmt_index];
+    if (N_sgmt == 0) {
+      coarse_counts.push_back(0);
+      continue;
+    }
+
+    size_t N_min = std::min(N_sgmt, guess_points.at(sgmt_index + 1).size());
+    coarse_counts.push_back(std::clamp(
+        static_cast<size_t>(std::lround(N_sgmt * fraction)), N_min, N_sgmt));
+  }
+
+  return coarse_counts;
+}
+
+/// Solves coarse levels of a path and returns the last level's solution
+/// resampled onto the path's control interval counts, for use as a warm start.
+///
+/// @tparam Generator The trajectory generator type.
+/// @param path_builder The path builder.
+/// @param handle An identifier for state callbacks.
+/// @param cancellation_token The cancellation token, also checked by the coarse
+///     solves.
+/// @param options The solver options. Its timeout covers every coarse level.
+/// @return The warm start, or std::nullopt if no coarse level was solved.
+template <typename Generator, typename Drivetrain, typename Solution>
+inline std::optional<Solution> solve_coarse_to_fine_levels(
+    const PathBuilder<Drivetrain, Solution>& path_builder, int64_t handle,
+    const CancellationToken& cancellation_token, const SolveOptions& options) {
+  const auto start_time = std::chrono::steady_clock::now();
+  const SegmentLayout full_layout{path_builder.get_control_interval_counts()};
+
+  std::optional<Solution> solution;
+  SegmentLayout layout;
+  for (double fraction : options.coarse_to_fine_levels) {
+    if (fraction <= 0.0 || fraction >= 1.0 ||
+        cancellation_token.is_cancelled()) {
+      continue;
+    }
+
+    SegmentLayout level_layout{
+        coarse_control_interval_counts(path_builder, fraction)};
+
+    // Coarse solutions aren't reported to the state callbacks
+    auto level_builder = path_builder;
+    level_builder.get_path().callbacks.clear();
+    level_builder.set_control_interval_counts(
+        std::vector{level_layout.control_interval_counts()});
+
+    auto level_options = options;
+    level_options.coarse_to_fine_levels.clear();
+    level_options.timeout = std::max<std::chrono::duration<double>>(
+        options.timeout - (std::chrono::steady_clock::now() - start_time),
+        std::chrono::duration<double>{0.0});
+
+    Generator generator{std::move(level_builder), handle, cancellation_token};
+    auto level_solution =
+        solution ? generator.generate(
+                       resample_solution(*solution, layout, level_layout),
+                       level_options)
+                 : generator.generate(level_options);
+    if (level_solution.has_value()) {
+      solution = std::move(level_solution.value());
+      layout = std::move(level_layout);
+    }
+  }
+
+  if (!solution) {
+    return std::nullopt;
+  }
+
+  return resample_solution(*solution, layout, full_layout);
+}
+
+}  // namespace trajopt
@@ -0,0 +1,169 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <variant>
+#include <vector>
+
+#include "trajopt/constraint/constraint.hpp"
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/path/path.hpp"
+#include "trajopt/util/segment_layout.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// The robot's state at one sample.
+struct TRAJOPT_DLLEXPORT SampleState {
+  /// The robot's pose.
+  Pose2d pose{};
+
+  /// The robot's linear velocity.
+  Translation2d linear_velocity{};
+
+  /// The robot's angular velocity.
+  double angular_velocity = 0.0;
+
+  /// The robot's linear acceleration.
+  Translation2d linear_acceleration{};
+
+  /// The robot's angular acceleration.
+  double angular_acceleration = 0.0;
+};
+
+/// Time spent applying constraints to a problem, per constraint type.
+struct TRAJOPT_DLLEXPORT ConstraintTiming {
+  /// Total time spent in apply(), indexed by Constraint::index() (see
+  /// constraint_type_names).
+  std::array<std::chrono::duration<double>, std::variant_size_v<Constraint>>
+      apply_time{};
+
+  /// Number of apply() calls, indexed by Constraint::index().
+  std::array<size_t, std::variant_size_v<Constraint>> apply_count{};
+
+  /// Records one apply() call.
+  ///
+  /// @param type The constraint's Constraint::index().
+  /// @param duration How long the call took.
+  void add(size_t type, std::chrono::duration<double> duration) {
+    apply_time[type] += duration;
+    ++apply_count[type];
+  }
+};
+
+/// Report of every path constraint evaluated at every sample it covers.
+///
+/// Each row is one constraint at one sample, stored column by column so a
+/// column can be scanned or exported without touching the others. Segment
+/// constraints are held by the waypoint that ends their segment, like in
+/// Waypoint::segment_constraints.
+struct TRAJOPT_DLLEXPORT ConstraintReport {
+  /// Index of the waypoint holding each row's constraint.
+  std::vector<size_t> wpt_index;
+
+  /// Whether each row's constraint is a segment constraint instead of a
+  /// waypoint constraint.
+  std::vector<bool> segment_constraint;
+
+  /// Index of each row's constraint within its waypoint's constraint list.
+  std::vector<size_t> constraint_index;
+
+  /// Constraint::index() of each row's constraint (see constraint_type_names).
+  std::vector<size_t> type;
+
+  /// Sample index of each row.
+  std::vector<size_t> sample;
+
+  /// Residual of each row (see EvaluableConstraint). NaN for user constraints
+  /// without a residual().
+  std::vector<double> residual;
+
+  /// Whether each row's constraint is active: violated, or within the active
+  /// tolerance of its bound. Equality constraints are always active.
+  std::vector<bool> active;
+
+  /// Time spent applying each constraint type while building the problem.
+  ConstraintTiming timing;
+
+  /// Number of constraints left out of the problem because other constraints
+  /// imply them (see simplify_constraints()). Their rows are still reported.
+  size_t removed_constraint_count = 0;
+
+  /// Returns the number of rows.
+  size_t size() const { return residual.size(); }
+};
+
+/// Evaluates every constraint in a path at every sample it covers.
+///
+/// @param path The path.
+/// @param layout The path's sample layout.
+/// @param states The robot's state at each sample.
+/// @param active_tolerance How close to zero an inequality's residual must be
+///     for it to count as active.
+/// @return The report, without timing.
+template <typename Drivetrain, typename Solution>
+ConstraintReport evaluate_constraints(const Path<Drivetrain, Solution>& path,
+                                      const SegmentLayout& layout,
+                                      const std::vector<SampleState>& states,
+                                      double active_tolerance) {
+  ConstraintReport report;
+
+  size_t row_count = 0;
+  for (size_t wpt_index = 0; wpt_index < path.waypoints.size(); ++wpt_index) {
+    const auto& wpt = path.waypoints[wpt_index];
+    row_count += wpt.waypoint_constraints.size();
+    if (wpt_index > 0) {
+      row_count += wpt.segment_constraints.size() *
+                   layout.interval_count(wpt_index - 1);
+    }
+  }
+  report.wpt_index.reserve(row_count);
+  report.segment_constraint.reserve(row_count);
+  report.constraint_index.reserve(row_count);
+  report.type.reserve(row_count);
+  report.sample.reserve(row_count);
+  report.residual.reserve(row_count);
+  report.active.reserve(row_count);
+
+  auto add_row = [&](size_t wpt_index, bool segment_constraint,
+                     size_t constraint_index, const Constraint& constraint,
+                     size_t sample) {
+    const auto& state = states[sample];
+    double residual = constraint_residual(
+        constraint, state.pose, state.linear_velocity, state.angular_velocity,
+        state.linear_acceleration, state.angular_acceleration);
+
+    report.wpt_index.push_back(wpt_index);
+    report.segment_constraint.push_back(segment_constraint);
+    report.constraint_index.push_back(constraint_index);
+    report.type.push_back(constraint.index());
+    report.sample.push_back(sample);
+    report.residual.push_back(residual);
+    report.active.push_back(residual >= -active_tolerance);
+  };
+
+  for (size_t wpt_index = 0; wpt_index < path.waypoints.size(); ++wpt_index) {
+    const auto& wpt = path.waypoints[wpt_index];
+    for (size_t i = 0; i < wpt.waypoint_constraints.size(); ++i) {
+      add_row(wpt_index, false, i, wpt.waypoint_constraints[i],
+              layout.index(wpt_index));
+    }
+    if (wpt_index == 0) {
+      continue;
+    }
+    for (size_t i = 0; i < wpt.segment_constraints.size(); ++i) {
+      for (size_t sample = layout.start(wpt_index - 1);
+           sample < layout.end(wpt_index - 1); ++sample) {
+        add_row(wpt_index, true, i, wpt.segment_constraints[i], sample);
+      }
+    }
+  }
+
+  return report;
+}
+
+}  // namespace trajopt
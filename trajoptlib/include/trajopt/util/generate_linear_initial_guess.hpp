@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "trajopt/geometry/pose2.hpp"
+#include "trajopt/util/segment_layout.hpp"
 #include "trajopt/util/trajopt_util.hpp"
 
 namespace trajopt {
@@ -24,8 +25,9 @@ template <typename Solution>
 inline Solution generate_linear_initial_guess(
     const std::vector<std::vector<Pose2d>>& initial_guess_points,
     const std::vector<size_t> control_interval_counts) {
-  size_t wpt_cnt = control_interval_counts.size() + 1;
-  size_t samp_tot = get_index(control_interval_counts, wpt_cnt - 1, 0) + 1;
+  const SegmentLayout layout{control_interval_counts};
+  size_t wpt_cnt = layout.waypoint_count();
+  size_t samp_tot = layout.sample_count();
 
   Solution initial_guess;
 
@@ -57,7 +59,7 @@ inline Solution generate_linear_initial_guess(
   }
 
   for (size_t wpt_index = 1; wpt_index < wpt_cnt; ++wpt_index) {
-    size_t N_sgmt = control_interval_counts.at(wpt_index - 1);
+    size_t N_sgmt = layout.interval_count(wpt_index - 1);
     size_t guess_point_count = initial_guess_points.at(wpt_index).size();
     size_t N_guess_sgmt = N_sgmt / guess_point_count;
     append_range(
@@ -4,6 +4,7 @@
 
 #include <cmath>
 #include <concepts>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -13,6 +14,7 @@
 #include "trajopt/spline/cubic_hermite_pose_spline_holonomic.hpp"
 #include "trajopt/spline/cubic_hermite_spline.hpp"
 #include "trajopt/spline/spline_helper.hpp"
+#include "trajopt/util/segment_layout.hpp"
 #include "trajopt/util/trajopt_util.hpp"
 
 namespace trajopt {
@@ -101,80 +103,84 @@ template <typename Solution>
 inline Solution generate_spline_initial_guess(
     const std::vector<std::vector<Pose2d>>& initial_guess_points,
     const std::vector<size_t> control_interval_counts) {
+  constexpr bool is_differential = std::same_as<Solution, DifferentialSolution>;
+
+  const SegmentLayout layout{control_interval_counts};
   std::vector<CubicHermitePoseSplineHolonomic> splines =
       splines_from_waypoints<Solution>(initial_guess_points);
-  std::vector<std::vector<PoseWithCurvature>> sgmt_points;
-  for (size_t i = 0; i < initial_guess_points.size(); ++i) {
-    for ([[maybe_unused]]
-         size_t j = 0;
-         j < initial_guess_points.at(i).size(); ++j) {
-      sgmt_points.push_back(std::vector<PoseWithCurvature>());
-    }
-  }
 
-  size_t traj_idx = 0;
-  if constexpr (std::same_as<Solution, DifferentialSolution>) {
-    sgmt_points.at(0).push_back(
-        splines.at(traj_idx).get_point(0, true).value());
+  size_t wpt_cnt = layout.waypoint_count();
+  size_t samp_tot = layout.sample_count();
+
+  // Every sample is written in place, so the solution is sized up front. The
+  // differential solution stores headings as angles, so their cosines and
+  // sines go to scratch arrays first.
+  Solution initial_guess;
+  initial_guess.x.resize(samp_tot);
+  initial_guess.y.resize(samp_tot);
+
+  std::vector<double> heading_scratch;
+  std::span<double> heading_cos;
+  std::span<double> heading_sin;
+  if constexpr (is_differential) {
+    initial_guess.heading.resize(samp_tot);
+    heading_scratch.resize(2 * samp_tot);
+    heading_cos = std::span{heading_scratch}.first(samp_tot);
+    heading_sin = std::span{heading_scratch}.last(samp_tot);
   } else {
-    sgmt_points.at(0).push_back(
-        splines.at(traj_idx).get_point(0, false).value());
+    initial_guess.thetacos.resize(samp_tot);
+    initial_guess.thetasin.resize(samp_tot);
+    heading_cos = initial_guess.thetacos;
+    heading_sin = initial_guess.thetasin;
   }
+
+  initial_guess.dt.assign(samp_tot, (wpt_cnt * 5.0) / samp_tot);
+
+  // Evaluates a spline at every point in t, writing the samples starting at
+  // sample_index
+  std::vector<double> t;
+  auto evaluate = [&](size_t spline_index, size_t sample_index) {
+    auto samples = [&](std::span<double> row) {
+      return row.subspan(sample_index, t.size());
+    };
+    splines.at(spline_index)
+        .get_poses(t, is_differential, samples(initial_guess.x),
+                   samples(initial_guess.y), samples(heading_cos),
+                   samples(heading_sin));
+  };
+
+  t.assign(1, 0.0);
+  evaluate(0, 0);
+
+  size_t traj_idx = 0;
+  size_t sample_index = 1;
   for (size_t sgmt_idx = 1; sgmt_idx < initial_guess_points.size();
        ++sgmt_idx) {
     auto guess_points_size = initial_guess_points.at(sgmt_idx).size();
-    auto samples_for_sgmt = control_interval_counts.at(sgmt_idx - 1);
+    auto samples_for_sgmt = layout.interval_count(sgmt_idx - 1);
     size_t samples = samples_for_sgmt / guess_points_size;
-    for (size_t guessIdx = 0; guessIdx < guess_points_size; ++guessIdx) {
-      if (guessIdx == (guess_points_size - 1)) {
+    for (size_t guess_idx = 0; guess_idx < guess_points_size; ++guess_idx) {
+      if (guess_idx == (guess_points_size - 1)) {
         samples += (samples_for_sgmt % guess_points_size);
       }
-      for (size_t sample_idx = 1; sample_idx < samples + 1; ++sample_idx) {
-        auto t = static_cast<double>(sample_idx) / samples;
-
-        if constexpr (std::same_as<Solution, DifferentialSolution>) {
-          const auto state = splines.at(traj_idx).get_point(t, true).value();
-          sgmt_points.at(traj_idx + 1).push_back(state);
-        } else {
-          const auto state = splines.at(traj_idx).get_point(t, false).value();
-          sgmt_points.at(traj_idx + 1).push_back(state);
-        }
+
+      t.resize(samples);
+      for (size_t i = 0; i < samples; ++i) {
+        t[i] = static_cast<double>(i + 1) / samples;
       }
+      evaluate(traj_idx, sample_index);
+      sample_index += samples;
+
       ++traj_idx;
     }
   }
 
-  size_t wpt_cnt = control_interval_counts.size() + 1;
-  size_t samp_tot = get_index(control_interval_counts, wpt_cnt - 1, 0) + 1;
-
-  Solution initial_guess;
-
-  initial_guess.x.reserve(samp_tot);
-  initial_guess.y.reserve(samp_tot);
-  if constexpr (std::same_as<Solution, DifferentialSolution>) {
-    initial_guess.heading.reserve(samp_tot);
-  } else {
-    initial_guess.thetacos.reserve(samp_tot);
-    initial_guess.thetasin.reserve(samp_tot);
-  }
-
-  initial_guess.dt.reserve(samp_tot);
-  for (size_t i = 0; i < samp_tot; ++i) {
-    initial_guess.dt.push_back((wpt_cnt * 5.0) / samp_tot);
-  }
-
-  for (auto sgmt : sgmt_points) {
-    for (auto pt : sgmt) {
-      initial_guess.x.push_back(pt.first.x());
-      initial_guess.y.push_back(pt.first.y());
-      if constexpr (std::same_as<Solution, DifferentialSolution>) {
-        initial_guess.heading.push_back(pt.first.rotation().radians());
-      } else {
-        initial_guess.thetacos.push_back(pt.first.rotation().cos());
-        initial_guess.thetasin.push_back(pt.first.rotation().sin());
-      }
+  if constexpr (is_differential) {
+    for (size_t i = 0; i < samp_tot; ++i) {
+      initial_guess.heading[i] = std::atan2(heading_sin[i], heading_cos[i]);
     }
   }
+
   return initial_guess;
 }
 
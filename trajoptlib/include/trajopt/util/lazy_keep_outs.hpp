@@ -0,0 +1,60 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+#include <sleipnir/optimization/problem.hpp>
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/solve_options.hpp"
+
+namespace trajopt {
+
+/// Solves a problem whose keep-out constraints are applied lazily.
+///
+/// Without SolveOptions::lazy_keep_outs, every keep-out constraint is applied
+/// before a single solve. Otherwise, only those near the obstacle at the
+/// current iterate are applied, and after each successful solve, those the
+/// solution violates are applied and the problem is re-solved from that
+/// solution until none are violated.
+///
+/// @param problem The problem.
+/// @param options The solver options. Its timeout covers every solve.
+/// @param activate_keep_outs Applies the inactive keep-out constraints whose
+///     clearance is less than their minimum distance plus its argument, and
+///     returns how many were applied.
+/// @return The exit status of the last solve.
+template <typename ActivateKeepOuts>
+slp::ExitStatus solve_with_lazy_keep_outs(
+    slp::Problem<double>& problem, const SolveOptions& options,
+    ActivateKeepOuts&& activate_keep_outs) {
+  const auto start_time = std::chrono::steady_clock::now();
+  auto solve = [&] {
+    return problem.solve(
+        {.tolerance = options.tolerance,
+         .max_iterations = options.max_iterations,
+         .timeout = std::max<std::chrono::duration<double>>(
+             options.timeout - (std::chrono::steady_clock::now() - start_time),
+             std::chrono::duration<double>{0.0}),
+         .diagnostics = options.diagnostics});
+  };
+
+  if (!options.lazy_keep_outs) {
+    activate_keep_outs(INFINITY);
+    return solve();
+  }
+
+  activate_keep_outs(options.keep_out_activation_distance);
+  while (true) {
+    auto status = solve();
+    if (status != slp::ExitStatus::SUCCESS || activate_keep_outs(0.0) == 0) {
+      return status;
+    }
+  }
+}
+
+}  // namespace trajopt
@@ -0,0 +1,143 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <memory>
+
+#include <sleipnir/autodiff/variable.hpp>
+
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/rotation2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// A constant of a trajectory optimization problem whose value can be changed
+/// after the problem is built.
+///
+/// Constraints that hold a Parameter build their expressions from variable()
+/// instead of a plain double. The solver treats it as a constant, but its
+/// value is read on every solve, so after set_value() a generator can
+/// resolve() without rebuilding its problem.
+///
+/// Copies of a Parameter share the same value, so a caller can keep a copy
+/// and update a constraint that was copied into a path. A Parameter must not
+/// be shared by generators running on different threads. The sub-problems of
+/// SolveOptions::split_at_stops use their own copies of built-in constraints'
+/// Parameters, and paths with user constraints aren't split.
+class TRAJOPT_DLLEXPORT Parameter {
+ public:
+  /// Constructs a Parameter.
+  ///
+  /// @param value The initial value.
+  explicit Parameter(double value = 0.0)
+      : m_variable{std::make_shared<slp::Variable<double>>()} {
+    m_variable->set_value(value);
+  }
+
+  /// Returns the current value.
+  double value() const { return m_variable->value(); }
+
+  /// Sets the value used by every solve from now on.
+  ///
+  /// @param value The new value.
+  void set_value(double value) { m_variable->set_value(value); }
+
+  /// Returns the variable that constraints build their expressions from.
+  const slp::Variable<double>& variable() const { return *m_variable; }
+
+  /// Returns true if both share the same value.
+  ///
+  /// @param other The other parameter.
+  bool operator==(const Parameter& other) const {
+    return m_variable == other.m_variable;
+  }
+
+ private:
+  // The variable isn't registered with a problem as a decision variable, so
+  // the solver never changes it
+  std::shared_ptr<slp::Variable<double>> m_variable;
+};
+
+/// A translation whose components are Parameters.
+struct TRAJOPT_DLLEXPORT TranslationParameter {
+  /// The x component.
+  Parameter x;
+
+  /// The y component.
+  Parameter y;
+
+  /// Constructs a TranslationParameter.
+  ///
+  /// @param translation The initial value.
+  explicit TranslationParameter(const Translation2d& translation = {})
+      : x{translation.x()}, y{translation.y()} {}
+
+  /// Returns the current value.
+  Translation2d value() const { return {x.value(), y.value()}; }
+
+  /// Sets the value used by every solve from now on.
+  ///
+  /// @param translation The new value.
+  void set_value(const Translation2d& translation) {
+    x.set_value(translation.x());
+    y.set_value(translation.y());
+  }
+
+  /// Returns the translation that constraints build their expressions from.
+  Translation2v<double> variable() const {
+    return {x.variable(), y.variable()};
+  }
+
+  /// Returns true if both share the same values.
+  bool operator==(const TranslationParameter& other) const = default;
+};
+
+/// A pose whose components are Parameters.
+///
+/// The heading is stored as its cosine and sine, so constraints on it stay
+/// polynomial in the decision variables.
+struct TRAJOPT_DLLEXPORT PoseParameter {
+  /// The translation.
+  TranslationParameter translation;
+
+  /// The heading's cosine.
+  Parameter cos;
+
+  /// The heading's sine.
+  Parameter sin;
+
+  /// Constructs a PoseParameter.
+  ///
+  /// @param pose The initial value.
+  explicit PoseParameter(const Pose2d& pose = {})
+      : translation{pose.translation()},
+        cos{pose.rotation().cos()},
+        sin{pose.rotation().sin()} {}
+
+  /// Returns the current value.
+  Pose2d value() const {
+    return {translation.value(), Rotation2d{cos.value(), sin.value()}};
+  }
+
+  /// Sets the value used by every solve from now on.
+  ///
+  /// @param pose The new value.
+  void set_value(const Pose2d& pose) {
+    translation.set_value(pose.translation());
+    cos.set_value(pose.rotation().cos());
+    sin.set_value(pose.rotation().sin());
+  }
+
+  /// Returns the pose that constraints build their expressions from.
+  Pose2v<double> variable() const {
+    return {translation.variable(),
+            Rotation2v<double>{cos.variable(), sin.variable()}};
+  }
+
+  /// Returns true if both share the same values.
+  bool operator==(const PoseParameter& other) const = default;
+};
+
+}  // namespace trajopt
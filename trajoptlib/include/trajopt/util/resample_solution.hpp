@@ -0,0 +1,232 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "trajopt/differential_trajectory_generator.hpp"
+#include "trajopt/geometry/rotation2.hpp"
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/util/segment_layout.hpp"
+
+namespace trajopt {
+
+/// Calls a function for each sample of a new segment layout with the source
+/// sample it lies in, the time since that source sample, and the new time
+/// step.
+///
+/// Each segment keeps its duration, and its new samples are spread evenly
+/// across it. The final sample always maps onto the source's final sample.
+///
+/// @param dt The source solution's time steps.
+/// @param from The source solution's segment layout.
+/// @param to The new segment layout. It must have the same number of segments
+///     as the source layout.
+/// @param sample A function called with the source sample index, the time
+///     since that sample, and the new time step, once per new sample in order.
+template <typename F>
+inline void for_each_resampled_sample(const std::vector<double>& dt,
+                                      const SegmentLayout& from,
+                                      const SegmentLayout& to, F&& sample) {
+  double last_dt = 0.0;
+  for (size_t sgmt_index = 0; sgmt_index < to.segment_count(); ++sgmt_index) {
+    size_t N_from = from.interval_count(sgmt_index);
+    size_t N_to = to.interval_count(sgmt_index);
+    size_t from_start = from.start(sgmt_index);
+
+    double sgmt_time = 0.0;
+    for (size_t index = from_start; index < from.end(sgmt_index); ++index) {
+      sgmt_time += dt[index];
+    }
+
+    double dt_from = N_from == 0 ? 0.0 : sgmt_time / N_from;
+    double dt_to = N_to == 0 ? 0.0 : sgmt_time / N_to;
+
+    for (size_t sample_index = 0; sample_index < N_to; ++sample_index) {
+      double t = sample_index * dt_to;
+
+      size_t interval = 0;
+      if (dt_from > 0.0) {
+        interval = std::min(static_cast<size_t>(t / dt_from), N_from - 1);
+      }
+
+      sample(from_start + interval, t - interval * dt_from, dt_to);
+    }
+
+    if (N_to > 0) {
+      last_dt = dt_to;
+    }
+  }
+
+  sample(from.sample_count() - 1, 0.0, last_dt);
+}
+
+/// Maps a swerve solution onto a new segment layout, e.g., after the control
+/// interval counts of a path changed, so it can still be used as a warm start.
+///
+/// The new samples are integrated from the preceding source sample with the
+/// same constant acceleration model as the kinematics constraints. Module
+/// forces are held constant across each source interval.
+///
+/// @param solution The swerve solution.
+/// @param from The solution's segment layout.
+/// @param to The new segment layout. It must have the same number of segments
+///     as the solution's.
+/// @return The resampled solution.
+inline SwerveSolution resample_solution(const SwerveSolution& solution,
+                                        const SegmentLayout& from,
+                                        const SegmentLayout& to) {
+  size_t samp_tot = to.sample_count();
+
+  SwerveSolution result;
+  for (auto* row : {&result.dt, &result.x, &result.y, &result.thetacos,
+                    &result.thetasin, &result.vx, &result.vy, &result.omega,
+                    &result.ax, &result.ay, &result.alpha}) {
+    row->reserve(samp_tot);
+  }
+  result.module_fx.resize(samp_tot, solution.module_fx.column_count());
+  result.module_fy.resize(samp_tot, solution.module_fy.column_count());
+
+  for_each_resampled_sample(
+      solution.dt, from, to, [&](size_t index, double t, double dt) {
+        // xₖ₊₁ = xₖ + vₖt + 1/2aₖt²
+        // θₖ₊₁ = θₖ + ωₖt + 1/2αₖt²
+        // vₖ₊₁ = vₖ + aₖt
+        // ωₖ₊₁ = ωₖ + αₖt
+        auto θ =
+            Rotation2d{solution.thetacos[index], solution.thetasin[index]}
+                .rotate_by(Rotation2d{solution.omega[index] * t +
+                                      0.5 * solution.alpha[index] * t * t});
+
+        std::ranges::copy(solution.module_fx[index],
+                          result.module_fx[result.dt.size()].begin());
+        std::ranges::copy(solution.module_fy[index],
+                          result.module_fy[result.dt.size()].begin());
+
+        result.dt.push_back(dt);
+        result.x.push_back(solution.x[index] + solution.vx[index] * t +
+                           0.5 * solution.ax[index] * t * t);
+        result.y.push_back(solution.y[index] + solution.vy[index] * t +
+                           0.5 * solution.ay[index] * t * t);
+        result.thetacos.push_back(θ.cos());
+        result.thetasin.push_back(θ.sin());
+        result.vx.push_back(solution.vx[index] + solution.ax[index] * t);
+        result.vy.push_back(solution.vy[index] + solution.ay[index] * t);
+        result.omega.push_back(solution.omega[index] +
+                               solution.alpha[index] * t);
+        result.ax.push_back(solution.ax[index]);
+        result.ay.push_back(solution.ay[index]);
+        result.alpha.push_back(solution.alpha[index]);
+      });
+
+  return result;
+}
+
+/// Maps a differential solution onto a new segment layout, e.g., after the
+/// control interval counts of a path changed, so it can still be used as a
+/// warm start.
+///
+/// The direct collocation constraints model each interval's inputs as linear
+/// and its states as cubic, so the new samples interpolate the wheel forces
+/// linearly, the pose with a cubic Hermite spline, and the velocities with a
+/// quadratic matching the source accelerations.
+///
+/// @param solution The differential solution.
+/// @param from The solution's segment layout.
+/// @param to The new segment layout. It must have the same number of segments
+///     as the solution's.
+/// @return The resampled solution.
+inline DifferentialSolution resample_solution(
+    const DifferentialSolution& solution, const SegmentLayout& from,
+    const SegmentLayout& to) {
+  size_t samp_tot = to.sample_count();
+
+  DifferentialSolution result;
+  for (auto* row :
+       {&result.dt, &result.x, &result.y, &result.heading, &result.vl,
+        &result.vr, &result.angular_velocity, &result.al, &result.ar,
+        &result.angular_acceleration, &result.Fl, &result.Fr}) {
+    row->reserve(samp_tot);
+  }
+
+  for_each_resampled_sample(
+      solution.dt, from, to, [&](size_t index, double t, double dt) {
+        const double h = solution.dt[index];
+        if (t == 0.0 || h <= 0.0) {
+          result.dt.push_back(dt);
+          result.x.push_back(solution.x[index]);
+          result.y.push_back(solution.y[index]);
+          result.heading.push_back(solution.heading[index]);
+          result.vl.push_back(solution.vl[index]);
+          result.vr.push_back(solution.vr[index]);
+          result.angular_velocity.push_back(solution.angular_velocity[index]);
+          result.al.push_back(solution.al[index]);
+          result.ar.push_back(solution.ar[index]);
+          result.angular_acceleration.push_back(
+              solution.angular_acceleration[index]);
+          result.Fl.push_back(solution.Fl[index]);
+          result.Fr.push_back(solution.Fr[index]);
+          return;
+        }
+
+        const double s = t / h;
+
+        // Cubic Hermite interpolation between samples k and k + 1
+        auto cubic = [&](const std::vector<double>& p, double pdot_k,
+                         double pdot_k_1) {
+          double s2 = s * s;
+          double s3 = s2 * s;
+          return (2 * s3 - 3 * s2 + 1) * p[index] +
+                 (s3 - 2 * s2 + s) * h * pdot_k +
+                 (-2 * s3 + 3 * s2) * p[index + 1] + (s3 - s2) * h * pdot_k_1;
+        };
+
+        // v(t) = vₖ + aₖt + (vₖ₊₁ − vₖ − aₖh)s²
+        auto quadratic = [&](const std::vector<double>& v,
+                             const std::vector<double>& a) {
+          return v[index] + a[index] * t +
+                 (v[index + 1] - v[index] - a[index] * h) * s * s;
+        };
+
+        // a(t) = aₖ + 2(vₖ₊₁ − vₖ − aₖh)t/h²
+        auto quadratic_derivative = [&](const std::vector<double>& v,
+                                        const std::vector<double>& a) {
+          return a[index] +
+                 2 * (v[index + 1] - v[index] - a[index] * h) * t / (h * h);
+        };
+
+        auto linear = [&](const std::vector<double>& u) {
+          return u[index] + (u[index + 1] - u[index]) * s;
+        };
+
+        double v_k = (solution.vl[index] + solution.vr[index]) / 2;
+        double v_k_1 = (solution.vl[index + 1] + solution.vr[index + 1]) / 2;
+        double θ_k = solution.heading[index];
+        double θ_k_1 = solution.heading[index + 1];
+
+        result.dt.push_back(dt);
+        result.x.push_back(cubic(solution.x, v_k * std::cos(θ_k),
+                                 v_k_1 * std::cos(θ_k_1)));
+        result.y.push_back(cubic(solution.y, v_k * std::sin(θ_k),
+                                 v_k_1 * std::sin(θ_k_1)));
+        result.heading.push_back(cubic(solution.heading,
+                                       solution.angular_velocity[index],
+                                       solution.angular_velocity[index + 1]));
+        result.vl.push_back(quadratic(solution.vl, solution.al));
+        result.vr.push_back(quadratic(solution.vr, solution.ar));
+        result.angular_velocity.push_back(quadratic(
+            solution.angular_velocity, solution.angular_acceleration));
+        result.al.push_back(quadratic_derivative(solution.vl, solution.al));
+        result.ar.push_back(quadratic_derivative(solution.vr, solution.ar));
+        result.angular_acceleration.push_back(quadratic_derivative(
+            solution.angular_velocity, solution.angular_acceleration));
+        result.Fl.push_back(linear(solution.Fl));
+        result.Fr.push_back(linear(solution.Fr));
+      });
+
+  return result;
+}
+
+}  // namespace trajopt
@@ -0,0 +1,103 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace trajopt {
+
+/// A fixed number of values per trajectory sample (e.g., one force per swerve
+/// module), stored in one contiguous sample-major array.
+///
+/// Indexing with a sample index returns a view of that sample's values, so
+/// matrix[sample][column] works like a nested vector without a heap
+/// allocation per sample.
+///
+/// @tparam T The element type.
+template <typename T>
+class SampleMatrix {
+ public:
+  /// Constructs an empty SampleMatrix.
+  SampleMatrix() = default;
+
+  /// Constructs a SampleMatrix of default-initialized values.
+  ///
+  /// @param sample_count The number of samples.
+  /// @param column_count The number of values per sample.
+  SampleMatrix(size_t sample_count, size_t column_count)
+      : m_sample_count{sample_count},
+        m_column_count{column_count},
+        m_values(sample_count * column_count) {}
+
+  /// Constructs a SampleMatrix from the values of each sample.
+  ///
+  /// @param samples Each sample's values. Every sample must have the same
+  ///     number of values.
+  SampleMatrix(std::initializer_list<std::initializer_list<T>> samples)
+      : m_sample_count{samples.size()},
+        m_column_count{samples.size() == 0 ? 0 : samples.begin()->size()} {
+    m_values.reserve(m_sample_count * m_column_count);
+    for (const auto& sample : samples) {
+      assert(sample.size() == m_column_count);
+      m_values.insert(m_values.end(), sample.begin(), sample.end());
+    }
+  }
+
+  /// Returns the number of samples.
+  size_t sample_count() const { return m_sample_count; }
+
+  /// Returns the number of values per sample.
+  size_t column_count() const { return m_column_count; }
+
+  /// Returns true if there are no samples.
+  bool empty() const { return m_sample_count == 0; }
+
+  /// Resizes the matrix. Existing values aren't kept in place if the column
+  /// count changes.
+  ///
+  /// @param sample_count The number of samples.
+  /// @param column_count The number of values per sample.
+  void resize(size_t sample_count, size_t column_count) {
+    m_sample_count = sample_count;
+    m_column_count = column_count;
+    m_values.resize(sample_count * column_count);
+  }
+
+  /// Returns a view of a sample's values.
+  ///
+  /// @param sample The sample index.
+  std::span<T> operator[](size_t sample) {
+    assert(sample < m_sample_count);
+    return std::span{m_values}.subspan(sample * m_column_count,
+                                       m_column_count);
+  }
+
+  /// Returns a view of a sample's values.
+  ///
+  /// @param sample The sample index.
+  std::span<const T> operator[](size_t sample) const {
+    assert(sample < m_sample_count);
+    return std::span{m_values}.subspan(sample * m_column_count,
+                                       m_column_count);
+  }
+
+  /// Returns a view of every value, sample-major.
+  std::span<T> values() { return m_values; }
+
+  /// Returns a view of every value, sample-major.
+  std::span<const T> values() const { return m_values; }
+
+  /// Returns true if both matrices have the same shape and values.
+  bool operator==(const SampleMatrix& other) const = default;
+
+ private:
+  size_t m_sample_count = 0;
+  size_t m_column_count = 0;
+  std::vector<T> m_values;
+};
+
+}  // namespace trajopt
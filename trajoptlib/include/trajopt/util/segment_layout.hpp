@@ -0,0 +1,84 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace trajopt {
+
+/// Layout of the samples in a discretized path.
+///
+/// Segment i spans the samples [start(i), end(i)], where sample end(i) is
+/// shared with the start of segment i + 1. The segment offsets are computed
+/// once from the control interval counts, so every lookup is constant time.
+class SegmentLayout {
+ public:
+  /// Constructs an empty SegmentLayout with one waypoint and no segments.
+  SegmentLayout() = default;
+
+  /// Constructs a SegmentLayout.
+  ///
+  /// @param control_interval_counts The control interval counts of each
+  ///     segment, in order.
+  explicit SegmentLayout(std::vector<size_t> control_interval_counts)
+      : m_control_interval_counts{std::move(control_interval_counts)} {
+    m_offsets.reserve(m_control_interval_counts.size() + 1);
+    for (size_t N_sgmt : m_control_interval_counts) {
+      m_offsets.push_back(m_offsets.back() + N_sgmt);
+    }
+  }
+
+  /// Returns the control interval counts of each segment, in order.
+  const std::vector<size_t>& control_interval_counts() const {
+    return m_control_interval_counts;
+  }
+
+  /// Returns the number of segments.
+  size_t segment_count() const { return m_control_interval_counts.size(); }
+
+  /// Returns the number of waypoints.
+  size_t waypoint_count() const { return m_control_interval_counts.size() + 1; }
+
+  /// Returns the total number of samples, including the initial sample.
+  size_t sample_count() const { return m_offsets.back() + 1; }
+
+  /// Returns the number of control intervals in a segment.
+  ///
+  /// @param sgmt_index The segment index, 0 indexed.
+  size_t interval_count(size_t sgmt_index) const {
+    return m_control_interval_counts[sgmt_index];
+  }
+
+  /// Returns the index of a segment's first sample.
+  ///
+  /// @param sgmt_index The segment index, 0 indexed.
+  size_t start(size_t sgmt_index) const { return m_offsets[sgmt_index]; }
+
+  /// Returns the index of a segment's last sample, which is also the first
+  /// sample of the next segment.
+  ///
+  /// @param sgmt_index The segment index, 0 indexed.
+  size_t end(size_t sgmt_index) const { return m_offsets[sgmt_index + 1]; }
+
+  /// Get the index of an item in a decision variable array, given the waypoint
+  /// and sample indices.
+  ///
+  /// This is the constant time equivalent of get_index().
+  ///
+  /// @param wpt_index The waypoint index, 0 indexed.
+  /// @param sample_index The sample index within the segment, 0 indexed.
+  /// @return The index in the array.
+  size_t index(size_t wpt_index, size_t sample_index = 0) const {
+    return m_offsets[wpt_index] + sample_index;
+  }
+
+ private:
+  std::vector<size_t> m_control_interval_counts;
+
+  // m_offsets[i] is the index of waypoint i's sample
+  std::vector<size_t> m_offsets{0};
+};
+
+}  // namespace trajopt
@@ -0,0 +1,144 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "trajopt/constraint/constraint.hpp"
+#include "trajopt/path/path.hpp"
+
+namespace trajopt {
+
+namespace detail {
+
+/// Returns true if satisfying lhs also satisfies rhs.
+template <typename T>
+bool implies(const T& lhs, const T& rhs) {
+  return lhs == rhs;
+}
+
+inline bool implies(const AngularVelocityMaxMagnitudeConstraint& lhs,
+                    const AngularVelocityMaxMagnitudeConstraint& rhs) {
+  return lhs.max_magnitude() <= rhs.max_magnitude();
+}
+
+inline bool implies(const LinearAccelerationMaxMagnitudeConstraint& lhs,
+                    const LinearAccelerationMaxMagnitudeConstraint& rhs) {
+  return lhs.max_magnitude() <= rhs.max_magnitude();
+}
+
+inline bool implies(const LinearVelocityMaxMagnitudeConstraint& lhs,
+                    const LinearVelocityMaxMagnitudeConstraint& rhs) {
+  return lhs.max_magnitude() <= rhs.max_magnitude();
+}
+
+inline bool implies(const PointAtConstraint& lhs,
+                    const PointAtConstraint& rhs) {
+  return lhs.has_same_field_point(rhs) && lhs.flip() == rhs.flip() &&
+         lhs.heading_tolerance() <= rhs.heading_tolerance();
+}
+
+/// Returns true if satisfying lhs also satisfies rhs.
+inline bool implies(const Constraint& lhs, const Constraint& rhs) {
+  if (lhs.index() != rhs.index()) {
+    return false;
+  }
+
+  return std::visit(
+      [&](const auto& lhs_constraint) {
+        using T = std::decay_t<decltype(lhs_constraint)>;
+        return implies(lhs_constraint, std::get<T>(rhs));
+      },
+      lhs);
+}
+
+/// Removes the constraints implied by another constraint in the same list.
+/// Of identical constraints, the first is kept.
+inline size_t remove_implied(std::vector<Constraint>& constraints) {
+  std::vector<Constraint> kept;
+  kept.reserve(constraints.size());
+
+  for (size_t i = 0; i < constraints.size(); ++i) {
+    bool redundant = false;
+    for (size_t j = 0; j < constraints.size() && !redundant; ++j) {
+      if (j == i || !implies(constraints[j], constraints[i])) {
+        continue;
+      }
+
+      // Of two constraints that imply each other, only the later is dropped
+      redundant = j < i || !implies(constraints[i], constraints[j]);
+    }
+
+    if (!redundant) {
+      kept.push_back(constraints[i]);
+    }
+  }
+
+  size_t removed = constraints.size() - kept.size();
+  constraints = std::move(kept);
+  return removed;
+}
+
+}  // namespace detail
+
+/// Removes duplicate and dominated constraints from a path before a generator
+/// applies them.
+///
+/// A segment constraint is added to the waypoint constraints of every
+/// waypoint in its range, and it's also applied to the first sample of each
+/// segment, which is the sample of the segment's starting waypoint.
+/// Overlapping ranges add more copies. This pass removes:
+///
+/// - identical constraints applied to the same samples
+/// - constraints a stricter one of the same type already covers (e.g., the
+///   larger of two maximum velocities, or the wider of two point-at heading
+///   tolerances)
+/// - waypoint constraints the following segment's constraints already apply to
+///   the waypoint's sample
+///
+/// @param path The path to simplify.
+/// @param control_interval_counts The path's control interval counts, which
+///     determine the samples each segment's constraints are applied to.
+/// @return The number of constraints removed.
+template <typename Drivetrain, typename Solution>
+size_t simplify_constraints(
+    Path<Drivetrain, Solution>& path,
+    const std::vector<size_t>& control_interval_counts) {
+  size_t removed = 0;
+
+  for (auto& waypoint : path.waypoints) {
+    removed += detail::remove_implied(waypoint.waypoint_constraints);
+    removed += detail::remove_implied(waypoint.segment_constraints);
+  }
+
+  // A segment's constraints also apply to its starting waypoint's sample, as
+  // long as the segment has at least one control interval
+  for (size_t sgmt_index = 0; sgmt_index < control_interval_counts.size() &&
+                              sgmt_index + 1 < path.waypoints.size();
+       ++sgmt_index) {
+    if (control_interval_counts[sgmt_index] == 0) {
+      continue;
+    }
+
+    const auto& sgmt_constraints =
+        path.waypoints[sgmt_index + 1].segment_constraints;
+    removed += std::erase_if(
+        path.waypoints[sgmt_index].waypoint_constraints,
+        [&](const Constraint& constraint) {
+          for (const auto& sgmt_constraint : sgmt_constraints) {
+            if (detail::implies(sgmt_constraint, constraint)) {
+              return true;
+            }
+          }
+          return false;
+        });
+  }
+
+  return removed;
+}
+
+}  // namespace trajopt
@@ -0,0 +1,162 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <variant>
+#include <vector>
+
+#include "trajopt/constraint/constraint.hpp"
+#include "trajopt/path/path.hpp"
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/transcription_method.hpp"
+
+namespace trajopt {
+
+/// Returns whether a waypoint pins the robot's full state, which holds if it
+/// has a pose equality constraint and zero linear and angular velocity
+/// constraints.
+///
+/// @param waypoint The waypoint.
+inline bool is_pinned_stop(const Waypoint& waypoint) {
+  bool pose_pinned = false;
+  bool linear_velocity_zero = false;
+  bool angular_velocity_zero = false;
+
+  for (const auto& constraint : waypoint.waypoint_constraints) {
+    if (std::holds_alternative<PoseEqualityConstraint>(constraint)) {
+      pose_pinned = true;
+    } else if (auto linear_velocity =
+                   std::get_if<LinearVelocityMaxMagnitudeConstraint>(
+                       &constraint)) {
+      linear_velocity_zero |= linear_velocity->max_magnitude() == 0.0;
+    } else if (auto angular_velocity =
+                   std::get_if<AngularVelocityMaxMagnitudeConstraint>(
+                       &constraint)) {
+      angular_velocity_zero |= angular_velocity->max_magnitude() == 0.0;
+    }
+  }
+
+  return pose_pinned && linear_velocity_zero && angular_velocity_zero;
+}
+
+/// Returns the indices of the intermediate waypoints a path can be split at.
+///
+/// A swerve path's segments only share state at their waypoints, and a pinned
+/// stop fixes that state, so the sub-paths on either side of one are
+/// independent problems whose solutions join into the path's solution.
+///
+/// @param path The path.
+template <typename Drivetrain, typename Solution>
+inline std::vector<size_t> find_split_waypoints(
+    const Path<Drivetrain, Solution>& path) {
+  std::vector<size_t> split_wpts;
+  for (size_t wpt_index = 1; wpt_index + 1 < path.waypoints.size();
+       ++wpt_index) {
+    if (is_pinned_stop(path.waypoints[wpt_index])) {
+      split_wpts.push_back(wpt_index);
+    }
+  }
+  return split_wpts;
+}
+
+/// Returns whether paths transcribed with a method can be split at their
+/// pinned stops.
+///
+/// The joined solution takes each stop's sample from the later sub-path, so it
+/// only matches the whole path's solution if no interval's dynamics use the
+/// acceleration at its end. Trapezoidal and Hermite-Simpson intervals do.
+///
+/// @param method The transcription method.
+inline bool can_split_at_stops(TranscriptionMethod method) {
+  return method == TranscriptionMethod::DEFAULT ||
+         method == TranscriptionMethod::EXPLICIT_EULER;
+}
+
+/// Returns whether a path has user constraints (see AnyConstraint).
+///
+/// Split sub-paths are built on separate threads, where Parameters mustn't be
+/// shared. Built-in constraints' Parameters can be replaced with their values
+/// (see unbind_parameters()), but user constraints' can't, so paths with them
+/// are solved whole.
+///
+/// @param path The path.
+template <typename Drivetrain, typename Solution>
+inline bool has_user_constraints(const Path<Drivetrain, Solution>& path) {
+  auto is_user_constraint = [](const Constraint& constraint) {
+    return std::holds_alternative<AnyConstraint>(constraint);
+  };
+  return std::ranges::any_of(path.waypoints, [&](const Waypoint& waypoint) {
+    return std::ranges::any_of(waypoint.waypoint_constraints,
+                               is_user_constraint) ||
+           std::ranges::any_of(waypoint.segment_constraints,
+                               is_user_constraint);
+  });
+}
+
+/// Joins the solutions of consecutive sub-paths into one solution.
+///
+/// Each sub-path starts at the waypoint the previous one ends at. That
+/// waypoint's sample is taken from the later sub-path, whose time step and
+/// acceleration start the next segment.
+///
+/// @param solutions The sub-path solutions, in path order.
+inline SwerveSolution join_solutions(
+    const std::vector<SwerveSolution>& solutions) {
+  SwerveSolution joined;
+
+  auto append = [](auto& to, const auto& from, bool include_last) {
+    if (!from.empty()) {
+      to.insert(to.end(), from.begin(),
+                include_last ? from.end() : std::ranges::prev(from.end()));
+    }
+  };
+
+  for (size_t i = 0; i < solutions.size(); ++i) {
+    const auto& solution = solutions[i];
+    bool include_last = i + 1 == solutions.size();
+
+    append(joined.dt, solution.dt, include_last);
+    append(joined.x, solution.x, include_last);
+    append(joined.y, solution.y, include_last);
+    append(joined.thetacos, solution.thetacos, include_last);
+    append(joined.thetasin, solution.thetasin, include_last);
+    append(joined.vx, solution.vx, include_last);
+    append(joined.vy, solution.vy, include_last);
+    append(joined.omega, solution.omega, include_last);
+    append(joined.ax, solution.ax, include_last);
+    append(joined.ay, solution.ay, include_last);
+    append(joined.alpha, solution.alpha, include_last);
+  }
+
+  // Module forces are copied into presized matrices in the same order
+  if (!solutions.empty()) {
+    size_t module_cnt = solutions.front().module_fx.column_count();
+    joined.module_fx.resize(joined.dt.size(), module_cnt);
+    joined.module_fy.resize(joined.dt.size(), module_cnt);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < solutions.size(); ++i) {
+      const auto& solution = solutions[i];
+      size_t sample_cnt = solution.module_fx.sample_count();
+      if (i + 1 < solutions.size() && sample_cnt > 0) {
+        --sample_cnt;
+      }
+
+      size_t value_cnt = sample_cnt * module_cnt;
+      std::ranges::copy(
+          solution.module_fx.values().first(value_cnt),
+          joined.module_fx.values().subspan(offset * module_cnt).begin());
+      std::ranges::copy(
+          solution.module_fy.values().first(value_cnt),
+          joined.module_fy.values().subspan(offset * module_cnt).begin());
+      offset += sample_cnt;
+    }
+  }
+
+  return joined;
+}
+
+}  // namespace trajopt
@@ -13,6 +13,9 @@ namespace trajopt {
 /// and sample indices and whether this array includes an entry for the initial
 /// sample point ("dt" does not, "x" does).
 ///
+/// This is linear in the waypoint index. Use SegmentLayout for repeated
+/// lookups.
+///
 /// @param N The control interval counts of each segment, in order.
 /// @param wpt_index The waypoint index, 0 indexed.
 /// @param sample_index The sample index within the segment, 0 indexed.
@@ -0,0 +1,212 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/batch_trajectory_generator.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <expected>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/util/segment_layout.hpp"
+
+namespace trajopt {
+
+namespace {
+
+/// A worker's queue of job indices. The owner pops from the front, and other
+/// workers steal from the back.
+class WorkQueue {
+ public:
+  void push(size_t job_index) {
+    std::scoped_lock lock{mutex};
+    job_indices.push_back(job_index);
+  }
+
+  std::optional<size_t> pop() {
+    std::scoped_lock lock{mutex};
+    if (job_indices.empty()) {
+      return std::nullopt;
+    }
+    size_t job_index = job_indices.front();
+    job_indices.pop_front();
+    return job_index;
+  }
+
+  std::optional<size_t> steal() {
+    std::scoped_lock lock{mutex};
+    if (job_indices.empty()) {
+      return std::nullopt;
+    }
+    size_t job_index = job_indices.back();
+    job_indices.pop_back();
+    return job_index;
+  }
+
+ private:
+  std::mutex mutex;
+  std::deque<size_t> job_indices;
+};
+
+/// Estimates the cost of solving a path from the number of decision variables
+/// and constraint applications.
+template <typename Drivetrain, typename Solution>
+size_t estimate_cost(const PathBuilder<Drivetrain, Solution>& path_builder,
+                     size_t variables_per_sample) {
+  const auto& path = path_builder.get_path();
+  const SegmentLayout layout{path_builder.get_control_interval_counts()};
+
+  size_t cost = layout.sample_count() * variables_per_sample;
+  for (size_t wpt_index = 0; wpt_index < path.waypoints.size(); ++wpt_index) {
+    cost += path.waypoints[wpt_index].waypoint_constraints.size();
+    if (wpt_index > 0 && wpt_index <= layout.segment_count()) {
+      cost += layout.interval_count(wpt_index - 1) *
+              path.waypoints[wpt_index].segment_constraints.size();
+    }
+  }
+
+  return cost;
+}
+
+}  // namespace
+
+BatchTrajectoryGenerator::BatchTrajectoryGenerator(size_t thread_count)
+    : thread_count{thread_count} {
+  if (this->thread_count == 0) {
+    this->thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+size_t BatchTrajectoryGenerator::add(SwervePathBuilder path_builder,
+                                     int64_t handle) {
+  // x, y, cosθ, sinθ, vx, vy, ω, ax, ay, α, dt, and Fx and Fy per module
+  size_t cost = estimate_cost(
+      path_builder, 11 + 2 * path_builder.get_path().drivetrain.modules.size());
+  jobs.emplace_back(std::move(path_builder), handle, CancellationToken{}, cost);
+  return jobs.size() - 1;
+}
+
+size_t BatchTrajectoryGenerator::add(DifferentialPathBuilder path_builder,
+                                     int64_t handle) {
+  // x, y, θ, vl, vr, al, ar, Fl, Fr, dt
+  size_t cost = estimate_cost(path_builder, 10);
+  jobs.emplace_back(std::move(path_builder), handle, CancellationToken{}, cost);
+  return jobs.size() - 1;
+}
+
+std::vector<BatchTrajectoryGenerator::Result>
+BatchTrajectoryGenerator::generate(bool diagnostics) {
+  SolveOptions options;
+  options.diagnostics = diagnostics;
+  return generate(options);
+}
+
+std::vector<BatchTrajectoryGenerator::Result>
+BatchTrajectoryGenerator::generate(const SolveOptions& options) {
+  std::vector<Result> results(jobs.size());
+  if (jobs.empty()) {
+    return results;
+  }
+
+  // Deal the jobs out largest first so each worker starts on its longest job
+  std::vector<size_t> order(jobs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::stable_sort(order, std::ranges::greater{}, [&](size_t index) {
+    return jobs[index].cost;
+  });
+
+  size_t worker_cnt = std::min(thread_count, jobs.size());
+  std::vector<WorkQueue> queues(worker_cnt);
+  for (size_t i = 0; i < order.size(); ++i) {
+    queues[i % worker_cnt].push(order[i]);
+  }
+
+  auto run_job = [&](size_t job_index) {
+    auto& job = jobs[job_index];
+
+    if (auto path_builder = std::get_if<SwervePathBuilder>(&job.path_builder)) {
+      if (job.cancellation_token.is_cancelled()) {
+        results[job_index] = SwerveResult{
+            std::unexpect, slp::ExitStatus::CALLBACK_REQUESTED_STOP};
+        return;
+      }
+
+      SwerveTrajectoryGenerator generator{*path_builder, job.handle,
+                                          job.cancellation_token};
+      results[job_index] = generator.generate(options);
+    } else {
+      if (job.cancellation_token.is_cancelled()) {
+        results[job_index] = DifferentialResult{
+            std::unexpect, slp::ExitStatus::CALLBACK_REQUESTED_STOP};
+        return;
+      }
+
+      DifferentialTrajectoryGenerator generator{
+          std::get<DifferentialPathBuilder>(job.path_builder), job.handle,
+          job.cancellation_token};
+      results[job_index] = generator.generate(options);
+    }
+  };
+
+  // An exception escaping a std::jthread terminates the process, so workers
+  // keep the first one for the calling thread to rethrow and stop taking jobs
+  std::mutex exception_mutex;
+  std::exception_ptr exception;
+  std::atomic<bool> failed{false};
+
+  // No jobs are added while generating, so a worker that finds every queue
+  // empty is done
+  auto work = [&](size_t worker_index) {
+    while (!failed.load()) {
+      auto job_index = queues[worker_index].pop();
+      for (size_t i = 1; !job_index && i < worker_cnt; ++i) {
+        job_index = queues[(worker_index + i) % worker_cnt].steal();
+      }
+
+      if (!job_index) {
+        return;
+      }
+
+      try {
+        run_job(job_index.value());
+      } catch (...) {
+        std::scoped_lock lock{exception_mutex};
+        if (!exception) {
+          exception = std::current_exception();
+        }
+        failed = true;
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(worker_cnt - 1);
+    for (size_t worker_index = 1; worker_index < worker_cnt; ++worker_index) {
+      workers.emplace_back(work, worker_index);
+    }
+
+    // The calling thread is the first worker
+    work(0);
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+
+  return results;
+}
+
+}  // namespace trajopt
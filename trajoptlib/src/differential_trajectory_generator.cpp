@@ -3,8 +3,12 @@
 #include "trajopt/differential_trajectory_generator.hpp"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <ranges>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include <sleipnir/autodiff/variable.hpp>
@@ -13,6 +17,11 @@
 #include "trajopt/geometry/rotation2.hpp"
 #include "trajopt/geometry/translation2.hpp"
 #include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/coarse_to_fine.hpp"
+#include "trajopt/util/constraint_report.hpp"
+#include "trajopt/util/lazy_keep_outs.hpp"
+#include "trajopt/util/segment_layout.hpp"
+#include "trajopt/util/simplify_constraints.hpp"
 #include "trajopt/util/trajopt_util.hpp"
 
 // Physics notation in this file:
@@ -40,10 +49,48 @@ inline Translation2v<double> wheel_to_chassis_speeds(slp::Variable<double> vl,
   return Translation2v<double>{(vl + vr) / 2, 0.0};
 }
 
+namespace {
+
+/// A differential drive's state, or its time derivative.
+struct DifferentialState {
+  slp::Variable<double> x{};
+  slp::Variable<double> y{};
+  slp::Variable<double> θ{};
+  slp::Variable<double> vl{};
+  slp::Variable<double> vr{};
+};
+
+/// Every member of DifferentialState
+constexpr std::array state_members{
+    &DifferentialState::x, &DifferentialState::y, &DifferentialState::θ,
+    &DifferentialState::vl, &DifferentialState::vr};
+
+}  // namespace
+
 DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
-    DifferentialPathBuilder path_builder, int64_t handle)
-    : path(path_builder.get_path()),
-      Ns(path_builder.get_control_interval_counts()) {
+    DifferentialPathBuilder path_builder, int64_t handle,
+    CancellationToken cancellation_token)
+    : path_builder(path_builder),
+      handle(handle),
+      path(path_builder.get_path()),
+      layout(path_builder.get_control_interval_counts()),
+      cancellation_token(std::move(cancellation_token)) {
+  removed_constraint_count =
+      simplify_constraints(path, path_builder.get_control_interval_counts());
+
+  // Precompute constant constraint geometry once instead of once per sample,
+  // and bind waypoint targets to parameters so set_waypoint_pose() can move
+  // them without rebuilding the problem
+  for (auto& waypoint : path.waypoints) {
+    for (auto& constraint : waypoint.waypoint_constraints) {
+      bind_target_parameters(constraint);
+      prepare_constraint(constraint);
+    }
+    for (auto& constraint : waypoint.segment_constraints) {
+      prepare_constraint(constraint);
+    }
+  }
+
   // See equations just before (12.35) and (12.36) in
   // https://controls-in-frc.link/ for wheel acceleration equations.
   //
@@ -57,57 +104,58 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
   //
   //   v = (vₗ + vᵣ) / 2
   //   ω = (vᵣ - vₗ) / (2r_b)
-
-  auto f =
-      [this](
-          const slp::VariableMatrix<double>& x,
-          const slp::VariableMatrix<double>& u) -> slp::VariableMatrix<double> {
-    slp::VariableMatrix<double> xdot{5};
-
-    const auto& m = path.drivetrain.mass;
-    double r_b = path.drivetrain.trackwidth / 2;
-    const auto& J = path.drivetrain.moi;
-
-    Eigen::Matrix<double, 2, 2> B{
-        {1.0 / m + r_b * r_b / J, 1.0 / m - r_b * r_b / J},
-        {1.0 / m - r_b * r_b / J, 1.0 / m + r_b * r_b / J}};
-
-    auto v = (x[3] + x[4]) / 2.0;
-    xdot[0] = v * cos(x[2]);
-    xdot[1] = v * sin(x[2]);
-    xdot[2] = (x[4] - x[3]) / path.drivetrain.trackwidth;
-    xdot.segment(3, 2) = B * u;
-
-    return xdot;
+  //
+  // B is constant and symmetric, so only its two distinct entries are kept,
+  // and the dynamics are built from scalars instead of VariableMatrix
+  // temporaries. x and y don't appear on the right-hand side.
+  const double m = path.drivetrain.mass;
+  const double r_b = path.drivetrain.trackwidth / 2;
+  const double J = path.drivetrain.moi;
+  const double B_same = 1.0 / m + r_b * r_b / J;
+  const double B_cross = 1.0 / m - r_b * r_b / J;
+
+  auto f = [&](const DifferentialState& x, const slp::Variable<double>& F_l,
+               const slp::Variable<double>& F_r) -> DifferentialState {
+    auto v = (x.vl + x.vr) / 2.0;
+    return {.x = v * cos(x.θ),
+            .y = v * sin(x.θ),
+            .θ = (x.vr - x.vl) / path.drivetrain.trackwidth,
+            .vl = B_same * F_l + B_cross * F_r,
+            .vr = B_cross * F_l + B_same * F_r};
   };
 
   auto initial_guess = path_builder.calculate_spline_initial_guess();
 
+  callback_times.resize(path.callbacks.size());
   problem.add_callback(
       [this, handle = handle](const slp::IterationInfo<double>&) -> bool {
-        constexpr int fps = 60;
-        constexpr std::chrono::duration<double> time_per_frame{1.0 / fps};
-
-        // FPS limit on sending updates
-        static auto last_frame_time = std::chrono::steady_clock::now();
+        // Rate limit on sending updates. The snapshot is only updated if at
+        // least one callback is due.
         auto now = std::chrono::steady_clock::now();
-        if (now - last_frame_time < time_per_frame) {
-          return trajopt::get_cancellation_flag();
-        }
-
-        last_frame_time = now;
-
-        auto soln = construct_differential_solution();
-        for (auto& callback : this->path.callbacks) {
-          callback(soln, handle);
+        bool snapshot_updated = false;
+        for (size_t i = 0; i < this->path.callbacks.size(); ++i) {
+          const auto& callback = this->path.callbacks[i];
+          if (!callback.is_due(now, callback_times[i])) {
+            continue;
+          }
+
+          if (!snapshot_updated) {
+            update_snapshot();
+            snapshot_updated = true;
+          }
+          callback_times[i] = now;
+          callback.function(snapshot, handle);
         }
 
-        return trajopt::get_cancellation_flag();
+        return this->cancellation_token.is_cancelled();
       });
 
-  size_t wpt_cnt = path.waypoints.size();
-  size_t sgmt_cnt = path.waypoints.size() - 1;
-  size_t samp_tot = get_index(Ns, wpt_cnt - 1, 0) + 1;
+  size_t wpt_cnt = layout.waypoint_count();
+  size_t sgmt_cnt = layout.segment_count();
+  size_t samp_tot = layout.sample_count();
+  const bool eliminate_accelerations =
+      path_builder.get_eliminate_accelerations();
+  const bool share_segment_dt = path_builder.get_share_segment_dt();
 
   x.reserve(samp_tot);
   y.reserve(samp_tot);
@@ -128,12 +176,39 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
     θ.emplace_back(problem.decision_variable());
     vl.emplace_back(problem.decision_variable());
     vr.emplace_back(problem.decision_variable());
-    al.emplace_back(problem.decision_variable());
-    ar.emplace_back(problem.decision_variable());
 
     Fl.emplace_back(problem.decision_variable());
     Fr.emplace_back(problem.decision_variable());
 
+    // In the reduced formulation, the wheel accelerations are the dynamics
+    // solved for them instead of decision variables
+    if (eliminate_accelerations) {
+      al.emplace_back(B_same * Fl.back() + B_cross * Fr.back());
+      ar.emplace_back(B_cross * Fl.back() + B_same * Fr.back());
+    } else {
+      al.emplace_back(problem.decision_variable());
+      ar.emplace_back(problem.decision_variable());
+    }
+
+    if (!share_segment_dt) {
+      dts.emplace_back(problem.decision_variable());
+    }
+  }
+
+  // With shared time steps, each segment's intervals all reference one time
+  // step variable, and the final sample keeps its own
+  if (share_segment_dt) {
+    for (size_t sgmt_index = 0; sgmt_index < sgmt_cnt; ++sgmt_index) {
+      if (layout.interval_count(sgmt_index) == 0) {
+        continue;
+      }
+
+      auto dt = problem.decision_variable();
+      for (size_t index = layout.start(sgmt_index);
+           index < layout.end(sgmt_index); ++index) {
+        dts.emplace_back(dt);
+      }
+    }
     dts.emplace_back(problem.decision_variable());
   }
 
@@ -147,17 +222,18 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
       path.drivetrain.wheel_radius * path.drivetrain.wheel_max_angular_velocity;
   const double chassis_max_ω = chassis_max_v * (path.drivetrain.trackwidth / 2);
   const double chassis_max_α = chassis_max_a * (path.drivetrain.trackwidth / 2);
-  for (size_t sgmt_index = 0; sgmt_index < Ns.size(); ++sgmt_index) {
-    size_t N_sgmt = Ns.at(sgmt_index);
-    size_t sgmt_start = get_index(Ns, sgmt_index);
-    size_t sgmt_end = get_index(Ns, sgmt_index + 1);
+  for (size_t sgmt_index = 0; sgmt_index < sgmt_cnt; ++sgmt_index) {
+    size_t N_sgmt = layout.interval_count(sgmt_index);
+    size_t sgmt_start = layout.start(sgmt_index);
+    size_t sgmt_end = layout.end(sgmt_index);
 
     if (N_sgmt == 0) {
       for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
         dts.at(index).set_value(0.0);
       }
     } else {
-      // Use initialGuess and Ns to find the dx, dy, dθ between wpts
+      // Use initialGuess and the segment layout to find the dx, dy, dθ
+      // between wpts
       const double dx =
           initial_guess.x.at(sgmt_end) - initial_guess.x.at(sgmt_start);
       const double dy =
@@ -175,7 +251,10 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
 
       for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
         auto& dt = dts.at(index);
-        problem.subject_to(slp::bounds(0, dt, 3));
+        // Shared time steps are bounded once instead of at every sample
+        if (!share_segment_dt || index == sgmt_start || index + 1 == samp_tot) {
+          problem.subject_to(slp::bounds(0, dt, 3));
+        }
         dt.set_value(sgmt_time / N_sgmt);
       }
     }
@@ -183,46 +262,89 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
   problem.minimize(std::accumulate(dts.begin(), dts.end(), slp::Variable{0.0}));
 
   // Apply dynamics constraints
-  for (size_t wpt_index = 0; wpt_index < wpt_cnt - 1; ++wpt_index) {
-    size_t N_sgmt = Ns.at(wpt_index);
+  const auto transcription_method = path_builder.get_transcription_method();
+  for (size_t wpt_index = 0; wpt_index < sgmt_cnt; ++wpt_index) {
+    size_t N_sgmt = layout.interval_count(wpt_index);
 
     for (size_t sample_index = 0; sample_index < N_sgmt; ++sample_index) {
-      size_t index = get_index(Ns, wpt_index, sample_index);
-
-      slp::VariableMatrix x_k{{x.at(index)},
-                              {y.at(index)},
-                              {θ.at(index)},
-                              {vl.at(index)},
-                              {vr.at(index)}};
-      slp::VariableMatrix u_k{{Fl.at(index)}, {Fr.at(index)}};
-
-      slp::VariableMatrix x_k_1{{x.at(index + 1)},
-                                {y.at(index + 1)},
-                                {θ.at(index + 1)},
-                                {vl.at(index + 1)},
-                                {vr.at(index + 1)}};
-      slp::VariableMatrix u_k_1{{Fl.at(index + 1)}, {Fr.at(index + 1)}};
+      size_t index = layout.index(wpt_index, sample_index);
+
+      DifferentialState x_k{.x = x.at(index),
+                            .y = y.at(index),
+                            .θ = θ.at(index),
+                            .vl = vl.at(index),
+                            .vr = vr.at(index)};
+      DifferentialState x_k_1{.x = x.at(index + 1),
+                              .y = y.at(index + 1),
+                              .θ = θ.at(index + 1),
+                              .vl = vl.at(index + 1),
+                              .vr = vr.at(index + 1)};
 
       auto dt_k = dts.at(index);
-      if (sample_index < N_sgmt - 1) {
+      if (!share_segment_dt && sample_index < N_sgmt - 1) {
         auto dt_k_1 = dts.at(index + 1);
         problem.subject_to(dt_k_1 == dt_k);
       }
 
-      // Dynamics constraints - direct collocation
-      // (https://mec560sbu.github.io/2016/09/30/direct_collocation/)
-      auto xdot_k = f(x_k, u_k);
-      auto xdot_k_1 = f(x_k_1, u_k_1);
-      auto xdot_c =
-          -3 / (2 * dt_k) * (x_k - x_k_1) - 0.25 * (xdot_k + xdot_k_1);
-
-      auto x_c = 0.5 * (x_k + x_k_1) + dt_k / 8 * (xdot_k - xdot_k_1);
-      auto u_c = 0.5 * (u_k + u_k_1);
-
-      problem.subject_to(xdot_c == f(x_c, u_c));
+      auto xdot_k = f(x_k, Fl.at(index), Fr.at(index));
+
+      switch (transcription_method) {
+        case TranscriptionMethod::EXPLICIT_EULER:
+          // xₖ₊₁ = xₖ + f(xₖ, uₖ)t
+          for (auto member : state_members) {
+            problem.subject_to(x_k_1.*member ==
+                               x_k.*member + xdot_k.*member * dt_k);
+          }
+          break;
+        case TranscriptionMethod::TRAPEZOIDAL: {
+          // xₖ₊₁ = xₖ + 1/2(f(xₖ, uₖ) + f(xₖ₊₁, uₖ₊₁))t
+          auto xdot_k_1 = f(x_k_1, Fl.at(index + 1), Fr.at(index + 1));
+          for (auto member : state_members) {
+            problem.subject_to(
+                x_k_1.*member ==
+                x_k.*member +
+                    (xdot_k.*member + xdot_k_1.*member) * 0.5 * dt_k);
+          }
+          break;
+        }
+        case TranscriptionMethod::DEFAULT:
+        case TranscriptionMethod::HERMITE_SIMPSON: {
+          // Dynamics constraints - direct collocation
+          // (https://mec560sbu.github.io/2016/09/30/direct_collocation/)
+          //
+          //   ẋ_c = −3/(2dt) (x_k − x_k+1) − ¼(ẋ_k + ẋ_k+1)
+          //   x_c = ½(x_k + x_k+1) + dt/8 (ẋ_k − ẋ_k+1)
+          //   u_c = ½(u_k + u_k+1)
+          //
+          // and ẋ_c = f(x_c, u_c). Only the heading and wheel velocities of
+          // x_c are needed, since f doesn't depend on position.
+          auto xdot_k_1 = f(x_k_1, Fl.at(index + 1), Fr.at(index + 1));
+
+          auto collocation_state = [&](auto member) {
+            return 0.5 * (x_k.*member + x_k_1.*member) +
+                   dt_k / 8.0 * (xdot_k.*member - xdot_k_1.*member);
+          };
+          DifferentialState x_c{
+              .θ = collocation_state(&DifferentialState::θ),
+              .vl = collocation_state(&DifferentialState::vl),
+              .vr = collocation_state(&DifferentialState::vr)};
+          auto xdot_c = f(x_c, 0.5 * (Fl.at(index) + Fl.at(index + 1)),
+                          0.5 * (Fr.at(index) + Fr.at(index + 1)));
+
+          auto defect_scale = -3.0 / (2.0 * dt_k);
+          for (auto member : state_members) {
+            problem.subject_to(defect_scale * (x_k.*member - x_k_1.*member) -
+                                   0.25 * (xdot_k.*member + xdot_k_1.*member) ==
+                               xdot_c.*member);
+          }
+          break;
+        }
+      }
 
-      problem.subject_to(al.at(index) == xdot_k[3]);
-      problem.subject_to(ar.at(index) == xdot_k[4]);
+      if (!eliminate_accelerations) {
+        problem.subject_to(al.at(index) == xdot_k.vl);
+        problem.subject_to(ar.at(index) == xdot_k.vr);
+      }
     }
   }
 
@@ -256,56 +378,78 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
     problem.subject_to(slp::bounds(-F_max, Fr.at(index), F_max));
   }
 
-  for (size_t wpt_index = 0; wpt_index < wpt_cnt; ++wpt_index) {
-    // First index of next wpt - 1
-    size_t index = get_index(Ns, wpt_index, 0);
+  // Constraints may seed auxiliary variables from the initial guess, so apply
+  // it first
+  apply_initial_guess(initial_guess);
 
-    Pose2v<double> pose_k{x.at(index), y.at(index), {θ.at(index)}};
-    Translation2v<double> v_k =
-        wheel_to_chassis_speeds(vl.at(index), vr.at(index));
-    auto ω_k = (vr.at(index) - vl.at(index)) / path.drivetrain.trackwidth;
-    Translation2v<double> a_k =
-        wheel_to_chassis_speeds(al.at(index), ar.at(index));
-    auto α_k = (ar.at(index) - al.at(index)) / path.drivetrain.trackwidth;
+  // Keep-out constraints are deferred to the first solve, which decides which
+  // samples need them
+  auto apply_or_defer = [&](size_t index, Constraint& constraint) {
+    if (std::holds_alternative<KeepOutPolygonConstraint>(constraint)) {
+      inactive_keep_outs.emplace_back(index, constraint);
+    } else {
+      apply_constraint(index, constraint);
+    }
+  };
 
+  for (size_t wpt_index = 0; wpt_index < wpt_cnt; ++wpt_index) {
     for (auto& constraint : path.waypoints.at(wpt_index).waypoint_constraints) {
-      std::visit(
-          [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
-          constraint);
+      apply_or_defer(layout.index(wpt_index), constraint);
     }
   }
 
   for (size_t sgmt_index = 0; sgmt_index < sgmt_cnt; ++sgmt_index) {
-    size_t start_index = get_index(Ns, sgmt_index, 0);
-    size_t end_index = get_index(Ns, sgmt_index + 1, 0);
+    size_t start_index = layout.start(sgmt_index);
+    size_t end_index = layout.end(sgmt_index);
 
     for (size_t index = start_index; index < end_index; ++index) {
-      Pose2v<double> pose_k{x.at(index), y.at(index), {θ.at(index)}};
-      Translation2v<double> v_k =
-          wheel_to_chassis_speeds(vl.at(index), vr.at(index));
-      auto ω_k = (vr.at(index) - vl.at(index)) / path.drivetrain.trackwidth;
-      Translation2v<double> a_k =
-          wheel_to_chassis_speeds(al.at(index), ar.at(index));
-      auto α_k = (ar.at(index) - al.at(index)) / path.drivetrain.trackwidth;
-
       for (auto& constraint :
            path.waypoints.at(sgmt_index + 1).segment_constraints) {
-        std::visit(
-            [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
-            constraint);
+        apply_or_defer(index, constraint);
       }
     }
   }
-
-  apply_initial_guess(initial_guess);
 }
 
 std::expected<DifferentialSolution, slp::ExitStatus>
 DifferentialTrajectoryGenerator::generate(bool diagnostics) {
-  get_cancellation_flag() = 0;
+  SolveOptions options;
+  options.diagnostics = diagnostics;
+  return generate(options);
+}
 
-  // tolerance of 1e-4 is 0.1 mm
-  auto status = problem.solve({.tolerance = 1e-4, .diagnostics = diagnostics});
+std::expected<DifferentialSolution, slp::ExitStatus>
+DifferentialTrajectoryGenerator::generate(const SolveOptions& options) {
+  if (options.coarse_to_fine_levels.empty()) {
+    return solve(options);
+  }
+
+  const auto start_time = std::chrono::steady_clock::now();
+  if (auto warm_start =
+          solve_coarse_to_fine_levels<DifferentialTrajectoryGenerator>(
+              path_builder, handle, cancellation_token, options)) {
+    apply_warm_start(warm_start.value());
+  }
+
+  auto full_options = options;
+  full_options.timeout =
+      std::max<std::chrono::duration<double>>(
+          options.timeout - (std::chrono::steady_clock::now() - start_time),
+          std::chrono::duration<double>{0.0});
+  return solve(full_options);
+}
+
+std::expected<DifferentialSolution, slp::ExitStatus>
+DifferentialTrajectoryGenerator::solve(const SolveOptions& options) {
+  auto status = solve_with_lazy_keep_outs(
+      problem, options,
+      [&](double distance) { return activate_keep_outs(distance); });
+
+  if (options.return_last_iterate_on_limit &&
+      (status == slp::ExitStatus::MAX_ITERATIONS_EXCEEDED ||
+       status == slp::ExitStatus::TIMEOUT)) {
+    return construct_differential_solution();
+  }
 
   if (static_cast<int>(status) < 0 ||
       status == slp::ExitStatus::CALLBACK_REQUESTED_STOP) {
@@ -315,6 +459,113 @@ DifferentialTrajectoryGenerator::generate(bool diagnostics) {
   }
 }
 
+std::expected<DifferentialSolution, slp::ExitStatus>
+DifferentialTrajectoryGenerator::generate(
+    const DifferentialSolution& warm_start, const SolveOptions& options) {
+  apply_warm_start(warm_start);
+  return solve(options);
+}
+
+std::expected<DifferentialSolution, slp::ExitStatus>
+DifferentialTrajectoryGenerator::resolve(const SolveOptions& options) {
+  return solve(options);
+}
+
+void DifferentialTrajectoryGenerator::set_waypoint_pose(size_t wpt_index,
+                                                       const Pose2d& pose) {
+  bool has_target = false;
+  bool has_heading = false;
+  for (auto& constraint : path.waypoints.at(wpt_index).waypoint_constraints) {
+    has_target |= set_target_pose(constraint, pose);
+    has_heading |= std::holds_alternative<PoseEqualityConstraint>(constraint);
+  }
+
+  // Keep the path builder's copy in sync, since coarse-to-fine levels are
+  // built from it
+  for (auto& constraint :
+       path_builder.get_path().waypoints.at(wpt_index).waypoint_constraints) {
+    set_target_pose(constraint, pose);
+  }
+
+  if (!has_target) {
+    return;
+  }
+
+  // Move the waypoint's sample onto the new target so the next solve starts
+  // from there
+  size_t index = layout.index(wpt_index);
+  x.at(index).set_value(pose.x());
+  y.at(index).set_value(pose.y());
+  if (has_heading) {
+    θ.at(index).set_value(pose.rotation().radians());
+  }
+}
+
+ConstraintReport DifferentialTrajectoryGenerator::constraint_report(
+    double active_tolerance) {
+  double trackwidth = path.drivetrain.trackwidth;
+
+  std::vector<SampleState> states;
+  states.reserve(x.size());
+  for (size_t index = 0; index < x.size(); ++index) {
+    double vl_k = vl[index].value();
+    double vr_k = vr[index].value();
+    double al_k = al[index].value();
+    double ar_k = ar[index].value();
+    states.push_back(
+        {.pose = {x[index].value(), y[index].value(), θ[index].value()},
+         .linear_velocity = wheel_to_chassis_speeds(vl_k, vr_k),
+         .angular_velocity = (vr_k - vl_k) / trackwidth,
+         .linear_acceleration = wheel_to_chassis_speeds(al_k, ar_k),
+         .angular_acceleration = (ar_k - al_k) / trackwidth});
+  }
+
+  auto report = evaluate_constraints(path_builder.get_path(), layout, states,
+                                     active_tolerance);
+  report.timing = constraint_timing;
+  report.removed_constraint_count = removed_constraint_count;
+  return report;
+}
+
+void DifferentialTrajectoryGenerator::apply_constraint(size_t index,
+                                                       Constraint& constraint) {
+  Pose2v<double> pose_k{x.at(index), y.at(index), {θ.at(index)}};
+  Translation2v<double> v_k =
+      wheel_to_chassis_speeds(vl.at(index), vr.at(index));
+  auto ω_k = (vr.at(index) - vl.at(index)) / path.drivetrain.trackwidth;
+  Translation2v<double> a_k =
+      wheel_to_chassis_speeds(al.at(index), ar.at(index));
+  auto α_k = (ar.at(index) - al.at(index)) / path.drivetrain.trackwidth;
+
+  auto start_time = std::chrono::steady_clock::now();
+  std::visit(
+      [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
+      constraint);
+  constraint_timing.add(constraint.index(),
+                        std::chrono::steady_clock::now() - start_time);
+}
+
+size_t DifferentialTrajectoryGenerator::activate_keep_outs(
+    double activation_distance) {
+  size_t activated = 0;
+  std::erase_if(inactive_keep_outs, [&](auto& keep_out) {
+    auto& [index, constraint] = keep_out;
+    const auto& keep_out_constraint =
+        std::get<KeepOutPolygonConstraint>(constraint);
+
+    Pose2d pose{x[index].value(), y[index].value(), {θ[index].value()}};
+    if (keep_out_constraint.distance(pose) >=
+        keep_out_constraint.min_distance() + activation_distance) {
+      return false;
+    }
+
+    apply_constraint(index, constraint);
+    ++activated;
+    return true;
+  });
+  return activated;
+}
+
 void DifferentialTrajectoryGenerator::apply_initial_guess(
     const DifferentialSolution& solution) {
   size_t sample_total = x.size();
@@ -324,10 +575,15 @@ void DifferentialTrajectoryGenerator::apply_initial_guess(
     θ[sample_index].set_value(solution.heading[sample_index]);
   }
 
+  // Eliminated accelerations follow the wheel forces instead
+  const bool guess_accelerations = !path_builder.get_eliminate_accelerations();
+
   vl[0].set_value(0.0);
   vr[0].set_value(0.0);
-  al[0].set_value(0.0);
-  ar[0].set_value(0.0);
+  if (guess_accelerations) {
+    al[0].set_value(0.0);
+    ar[0].set_value(0.0);
+  }
 
   for (size_t sample_index = 1; sample_index < sample_total; ++sample_index) {
     double linear_velocity =
@@ -344,46 +600,86 @@ void DifferentialTrajectoryGenerator::apply_initial_guess(
         (linear_velocity - path.drivetrain.trackwidth / 2 * ω));
     vr[sample_index].set_value(
         (linear_velocity + path.drivetrain.trackwidth / 2 * ω));
-    al[sample_index].set_value(
-        (vl[sample_index].value() - vl[sample_index - 1].value()) /
-        solution.dt[sample_index]);
-    ar[sample_index].set_value(
-        (vr[sample_index].value() - vr[sample_index - 1].value()) /
-        solution.dt[sample_index]);
+    if (guess_accelerations) {
+      al[sample_index].set_value(
+          (vl[sample_index].value() - vl[sample_index - 1].value()) /
+          solution.dt[sample_index]);
+      ar[sample_index].set_value(
+          (vr[sample_index].value() - vr[sample_index - 1].value()) /
+          solution.dt[sample_index]);
+    }
   }
 }
 
-DifferentialSolution
-DifferentialTrajectoryGenerator::construct_differential_solution() {
-  auto get_value = [](auto& var) { return var.value(); };
+void DifferentialTrajectoryGenerator::apply_warm_start(
+    const DifferentialSolution& solution) {
+  size_t sample_total = x.size();
+
+  // The chassis angular velocity and acceleration are derived from the wheel
+  // states, so they aren't decision variables
+  if (!std::ranges::all_of(
+          std::array{&solution.dt, &solution.x, &solution.y,
+                     &solution.heading, &solution.vl, &solution.vr,
+                     &solution.al, &solution.ar, &solution.Fl, &solution.Fr},
+          [&](const auto* row) { return row->size() == sample_total; })) {
+    return;
+  }
+
+  for (size_t sample_index = 0; sample_index < sample_total; ++sample_index) {
+    dts[sample_index].set_value(solution.dt[sample_index]);
+    x[sample_index].set_value(solution.x[sample_index]);
+    y[sample_index].set_value(solution.y[sample_index]);
+    θ[sample_index].set_value(solution.heading[sample_index]);
+    vl[sample_index].set_value(solution.vl[sample_index]);
+    vr[sample_index].set_value(solution.vr[sample_index]);
+    if (!path_builder.get_eliminate_accelerations()) {
+      al[sample_index].set_value(solution.al[sample_index]);
+      ar[sample_index].set_value(solution.ar[sample_index]);
+    }
+    Fl[sample_index].set_value(solution.Fl[sample_index]);
+    Fr[sample_index].set_value(solution.Fr[sample_index]);
+  }
+}
 
-  auto vector_value = [&](std::vector<slp::Variable<double>>& row) {
-    return row | std::views::transform(get_value) |
-           std::ranges::to<std::vector>();
+const DifferentialSolution& DifferentialTrajectoryGenerator::update_snapshot() {
+  // Resizing only allocates on the first update
+  auto copy_values = [](std::vector<slp::Variable<double>>& variables,
+                        std::vector<double>& values) {
+    values.resize(variables.size());
+    for (size_t i = 0; i < variables.size(); ++i) {
+      values[i] = variables[i].value();
+    }
   };
+
+  copy_values(dts, snapshot.dt);
+  copy_values(x, snapshot.x);
+  copy_values(y, snapshot.y);
+  copy_values(θ, snapshot.heading);
+  copy_values(vl, snapshot.vl);
+  copy_values(vr, snapshot.vr);
+  copy_values(al, snapshot.al);
+  copy_values(ar, snapshot.ar);
+  copy_values(Fl, snapshot.Fl);
+  copy_values(Fr, snapshot.Fr);
+
   const auto& trackwidth = path.drivetrain.trackwidth;
-  std::vector<double> ω;
+  snapshot.angular_velocity.resize(vl.size());
   for (size_t sample = 0; sample < vl.size(); ++sample) {
-    ω.push_back((vr.at(sample).value() - vl.at(sample).value()) / trackwidth);
+    snapshot.angular_velocity[sample] =
+        (snapshot.vr[sample] - snapshot.vl[sample]) / trackwidth;
   }
-  std::vector<double> α;
+  snapshot.angular_acceleration.resize(al.size());
   for (size_t sample = 0; sample < al.size(); ++sample) {
-    α.push_back((ar.at(sample).value() - al.at(sample).value()) / trackwidth);
+    snapshot.angular_acceleration[sample] =
+        (snapshot.ar[sample] - snapshot.al[sample]) / trackwidth;
   }
-  return DifferentialSolution{
-      vector_value(dts),
-      vector_value(x),
-      vector_value(y),
-      vector_value(θ),
-      vector_value(vl),
-      vector_value(vr),
-      ω,
-      vector_value(al),
-      vector_value(ar),
-      α,
-      vector_value(Fl),
-      vector_value(Fr),
-  };
+
+  return snapshot;
+}
+
+DifferentialSolution
+DifferentialTrajectoryGenerator::construct_differential_solution() {
+  return update_snapshot();
 }
 
 }  // namespace trajopt
@@ -77,6 +77,17 @@ mod ffi {
         samples: Vec<DifferentialTrajectorySample>,
     }
 
+    #[derive(Debug, Deserialize, Serialize, Clone)]
+    struct SolveOptions {
+        tolerance: f64,
+        max_iterations: i32,
+        timeout: f64,
+        return_last_iterate_on_limit: bool,
+        split_at_stops: bool,
+        lazy_keep_outs: bool,
+        diagnostics: bool,
+    }
+
     unsafe extern "C++" {
         include!("rust_ffi.hpp");
 
@@ -284,6 +295,7 @@ mod ffi {
         fn add_callback(
             self: Pin<&mut SwerveTrajectoryGenerator>,
             callback: fn(SwerveTrajectory, i64),
+            max_rate: f64,
         );
 
         fn generate(
@@ -292,6 +304,12 @@ mod ffi {
             uuid: i64,
         ) -> Result<SwerveTrajectory>;
 
+        fn generate_with_options(
+            self: &SwerveTrajectoryGenerator,
+            options: &SolveOptions,
+            uuid: i64,
+        ) -> Result<SwerveTrajectory>;
+
         type DifferentialTrajectoryGenerator;
 
         fn differential_trajectory_generator_new() -> UniquePtr<DifferentialTrajectoryGenerator>;
@@ -489,6 +507,7 @@ mod ffi {
         fn add_callback(
             self: Pin<&mut DifferentialTrajectoryGenerator>,
             callback: fn(DifferentialTrajectory, i64),
+            max_rate: f64,
         );
 
         fn generate(
@@ -497,7 +516,15 @@ mod ffi {
             uuid: i64,
         ) -> Result<DifferentialTrajectory>;
 
-        // Cancel all generators
+        fn generate_with_options(
+            self: &DifferentialTrajectoryGenerator,
+            options: &SolveOptions,
+            uuid: i64,
+        ) -> Result<DifferentialTrajectory>;
+
+        // Cancellation
+
+        fn cancel(handle: i64);
 
         fn cancel_all();
     }
@@ -864,10 +891,16 @@ impl SwerveTrajectoryGenerator {
     /// * callback: a `fn` (not a closure) to be executed. The callback's first
     ///   parameter will be a `trajopt::SwerveTrajectory`, and the second
     ///   parameter will be an `i64` equal to the handle passed in `generate()`
+    /// * max_rate: The maximum rate at which the callback is called (Hz).
+    ///   Infinity calls it on every iteration, and zero disables it.
     ///
     /// This function can be called multiple times to add multiple callbacks.
-    pub fn add_callback(&mut self, callback: fn(SwerveTrajectory, i64)) {
-        crate::ffi::SwerveTrajectoryGenerator::add_callback(self.generator.pin_mut(), callback);
+    pub fn add_callback(&mut self, callback: fn(SwerveTrajectory, i64), max_rate: f64) {
+        crate::ffi::SwerveTrajectoryGenerator::add_callback(
+            self.generator.pin_mut(),
+            callback,
+            max_rate,
+        );
     }
 
     ///
@@ -897,6 +930,34 @@ impl SwerveTrajectoryGenerator {
             }
         }
     }
+
+    ///
+    /// Generate the trajectory with the given solver options;
+    ///
+    /// * options: The solver's tolerance, iteration limit, time limit, and
+    ///   whether to return the last iterate when a limit is hit.
+    /// * handle: A number used to identify results from this generation in the
+    ///   `add_callback` callback. If `add_callback` has not been called, this
+    ///   value has no significance.
+    ///
+    /// Returns a result with either the final `trajopt::SwerveTrajectory`,
+    /// or a TrajoptError if generation failed.
+    pub fn generate_with_options(
+        &self,
+        options: &SolveOptions,
+        handle: i64,
+    ) -> Result<SwerveTrajectory, TrajoptError> {
+        match self.generator.generate_with_options(options, handle) {
+            Ok(trajectory) => Ok(trajectory),
+            Err(msg) => {
+                let what = msg.what();
+                Err(TrajoptError::from(
+                    what.parse::<i8>()
+                        .map_err(|_| TrajoptError::Unparsable(Box::from(what)))?,
+                ))
+            }
+        }
+    }
 }
 
 pub struct DifferentialTrajectoryGenerator {
@@ -1243,12 +1304,15 @@ impl DifferentialTrajectoryGenerator {
     /// * callback: a `fn` (not a closure) to be executed. The callback's first
     ///   parameter will be a `trajopt::DifferentialTrajectory`, and the second
     ///   parameter will be an `i64` equal to the handle passed in `generate()`
+    /// * max_rate: The maximum rate at which the callback is called (Hz).
+    ///   Infinity calls it on every iteration, and zero disables it.
     ///
     /// This function can be called multiple times to add multiple callbacks.
-    pub fn add_callback(&mut self, callback: fn(DifferentialTrajectory, i64)) {
+    pub fn add_callback(&mut self, callback: fn(DifferentialTrajectory, i64), max_rate: f64) {
         crate::ffi::DifferentialTrajectoryGenerator::add_callback(
             self.generator.pin_mut(),
             callback,
+            max_rate,
         );
     }
 
@@ -1280,8 +1344,56 @@ impl DifferentialTrajectoryGenerator {
             }
         }
     }
+
+    ///
+    /// Generate the trajectory with the given solver options;
+    ///
+    /// * options: The solver's tolerance, iteration limit, time limit, and
+    ///   whether to return the last iterate when a limit is hit.
+    /// * handle: A number used to identify results from this generation in the
+    ///   `add_callback` callback. If `add_callback` has not been called, this
+    ///   value has no significance.
+    ///
+    /// Returns a result with either the final `trajopt::DifferentialTrajectory`,
+    /// or a TrajoptError if generation failed.
+    pub fn generate_with_options(
+        &self,
+        options: &SolveOptions,
+        handle: i64,
+    ) -> Result<DifferentialTrajectory, TrajoptError> {
+        match self.generator.generate_with_options(options, handle) {
+            Ok(trajectory) => Ok(trajectory),
+            Err(msg) => {
+                let what = msg.what();
+                Err(TrajoptError::from(
+                    what.parse::<i8>()
+                        .map_err(|_| TrajoptError::Unparsable(Box::from(what)))?,
+                ))
+            }
+        }
+    }
+}
+
+impl Default for SolveOptions {
+    fn default() -> Self {
+        SolveOptions {
+            tolerance: 1e-4,
+            max_iterations: 5000,
+            timeout: f64::INFINITY,
+            return_last_iterate_on_limit: false,
+            split_at_stops: false,
+            lazy_keep_outs: false,
+            diagnostics: false,
+        }
+    }
+}
+
+/// Cancels the running generations started with the given handle.
+pub fn cancel(handle: i64) {
+    crate::ffi::cancel(handle);
 }
 
+/// Cancels every running generation.
 pub fn cancel_all() {
     crate::ffi::cancel_all();
 }
@@ -1291,6 +1403,7 @@ pub use ffi::DifferentialDrivetrain;
 pub use ffi::DifferentialTrajectory;
 pub use ffi::DifferentialTrajectorySample;
 pub use ffi::Pose2d;
+pub use ffi::SolveOptions;
 pub use ffi::SwerveDrivetrain;
 pub use ffi::SwerveTrajectory;
 pub use ffi::SwerveTrajectorySample;
@@ -5,24 +5,153 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 #include "trajopt/constraint/angular_velocity_max_magnitude_constraint.hpp"
+#include "trajopt/constraint/keep_in_polygon_constraint.hpp"
+#include "trajopt/constraint/keep_out_polygon_constraint.hpp"
 #include "trajopt/constraint/lane_constraint.hpp"
 #include "trajopt/constraint/linear_acceleration_max_magnitude_constraint.hpp"
 #include "trajopt/constraint/linear_velocity_direction_constraint.hpp"
 #include "trajopt/constraint/linear_velocity_max_magnitude_constraint.hpp"
 #include "trajopt/constraint/point_at_constraint.hpp"
-#include "trajopt/constraint/point_line_region_constraint.hpp"
 #include "trajopt/geometry/translation2.hpp"
 #include "trajopt/util/cancellation.hpp"
 #include "trajoptlib/src/lib.rs.h"
 
 namespace trajopt::rsffi {
 
+namespace {
+
+/// Cancellation tokens of the generations currently running, with their
+/// handles.
+std::mutex running_tokens_mutex;
+std::vector<std::pair<int64_t, trajopt::CancellationToken>> running_tokens;
+
+/// Registers a generation's cancellation token with its handle for the
+/// lifetime of this object so cancel() can find it.
+class RunningGeneration {
+ public:
+  explicit RunningGeneration(int64_t handle) {
+    std::scoped_lock lock{running_tokens_mutex};
+    running_tokens.emplace_back(handle, token);
+  }
+
+  ~RunningGeneration() {
+    std::scoped_lock lock{running_tokens_mutex};
+    std::erase_if(running_tokens,
+                  [&](const auto& entry) { return entry.second == token; });
+  }
+
+  const trajopt::CancellationToken& get_token() const { return token; }
+
+ private:
+  trajopt::CancellationToken token;
+};
+
+std::vector<trajopt::Translation2d> to_field_polygon(
+    const rust::Vec<double>& field_points_x,
+    const rust::Vec<double>& field_points_y) {
+  std::vector<trajopt::Translation2d> field_polygon;
+  field_polygon.reserve(field_points_x.size());
+  for (size_t i = 0; i < field_points_x.size(); ++i) {
+    field_polygon.emplace_back(field_points_x[i], field_points_y[i]);
+  }
+  return field_polygon;
+}
+
+trajopt::SolveOptions to_cpp_options(const SolveOptions& options) {
+  trajopt::SolveOptions cpp_options;
+  cpp_options.tolerance = options.tolerance;
+  cpp_options.max_iterations = options.max_iterations;
+  cpp_options.timeout = std::chrono::duration<double>{options.timeout};
+  cpp_options.return_last_iterate_on_limit =
+      options.return_last_iterate_on_limit;
+  cpp_options.split_at_stops = options.split_at_stops;
+  cpp_options.lazy_keep_outs = options.lazy_keep_outs;
+  cpp_options.diagnostics = options.diagnostics;
+  return cpp_options;
+}
+
+/// Converts a swerve solution directly into Rust samples, without building an
+/// intermediate trajopt::SwerveTrajectory.
+SwerveTrajectory to_rust_trajectory(const trajopt::SwerveSolution& solution) {
+  rust::Vec<SwerveTrajectorySample> rust_samples;
+  rust_samples.reserve(solution.x.size());
+
+  double timestamp = 0.0;
+  for (size_t sample = 0; sample < solution.x.size(); ++sample) {
+    auto sample_fx = solution.module_fx[sample];
+    rust::Vec<double> fx;
+    fx.reserve(sample_fx.size());
+    std::copy(sample_fx.begin(), sample_fx.end(), std::back_inserter(fx));
+
+    auto sample_fy = solution.module_fy[sample];
+    rust::Vec<double> fy;
+    fy.reserve(sample_fy.size());
+    std::copy(sample_fy.begin(), sample_fy.end(), std::back_inserter(fy));
+
+    rust_samples.push_back(SwerveTrajectorySample{
+        timestamp, solution.x[sample], solution.y[sample],
+        std::atan2(solution.thetasin[sample], solution.thetacos[sample]),
+        solution.vx[sample], solution.vy[sample], solution.omega[sample],
+        solution.ax[sample], solution.ay[sample], solution.alpha[sample],
+        std::move(fx), std::move(fy)});
+    timestamp += solution.dt[sample];
+  }
+
+  return SwerveTrajectory{std::move(rust_samples)};
+}
+
+/// Converts a differential solution directly into Rust samples, without
+/// building an intermediate trajopt::DifferentialTrajectory.
+DifferentialTrajectory to_rust_trajectory(
+    const trajopt::DifferentialSolution& solution) {
+  rust::Vec<DifferentialTrajectorySample> rust_samples;
+  rust_samples.reserve(solution.x.size());
+
+  double timestamp = 0.0;
+  for (size_t sample = 0; sample < solution.x.size(); ++sample) {
+    rust_samples.push_back(DifferentialTrajectorySample{
+        timestamp, solution.x[sample], solution.y[sample],
+        solution.heading[sample], solution.vl[sample], solution.vr[sample],
+        solution.angular_velocity[sample], solution.al[sample],
+        solution.ar[sample], solution.angular_acceleration[sample],
+        solution.Fl[sample], solution.Fr[sample]});
+    timestamp += solution.dt[sample];
+  }
+
+  return DifferentialTrajectory{std::move(rust_samples)};
+}
+
+/// Generates a path builder's trajectory and converts it for Rust.
+///
+/// @tparam Generator The C++ trajectory generator type.
+/// @param path_builder The path builder.
+/// @param options The solver options.
+/// @param handle An identifier for state callbacks and cancellation.
+template <typename Generator, typename PathBuilder>
+auto generate_trajectory(const PathBuilder& path_builder,
+                         const trajopt::SolveOptions& options,
+                         int64_t handle) {
+  RunningGeneration running{handle};
+  Generator generator{path_builder, handle, running.get_token()};
+  if (auto sol = generator.generate(options); sol.has_value()) {
+    return to_rust_trajectory(sol.value());
+  } else {
+    throw sol.error();
+  }
+}
+
+}  // namespace
+
 void SwerveTrajectoryGenerator::set_drivetrain(
     const SwerveDrivetrain& drivetrain) {
   std::vector<trajopt::Translation2d> cpp_modules;
@@ -141,25 +270,9 @@ void SwerveTrajectoryGenerator::wpt_keep_in_polygon(
   if (field_points_x.size() != field_points_y.size()) {
     return;
   }
-  for (size_t i = 0; i < field_points_x.size(); i++) {
-    auto j = (i + 1) % field_points_x.size();
-    path_builder.wpt_constraint(index,
-                                trajopt::PointLineRegionConstraint{
-                                    {0.0, 0.0},
-                                    {field_points_x[i], field_points_y[i]},
-                                    {field_points_x[j], field_points_y[j]},
-                                    Side::ABOVE});
-    for (const auto& bumper : path_builder.get_bumpers()) {
-      for (const auto& corner : bumper.points) {
-        path_builder.wpt_constraint(index,
-                                    trajopt::PointLineRegionConstraint{
-                                        corner,
-                                        {field_points_x[i], field_points_y[i]},
-                                        {field_points_x[j], field_points_y[j]},
-                                        Side::ABOVE});
-      }
-    }
-  }
+  path_builder.wpt_constraint(
+      index, path_builder.keep_in_polygon(
+                 to_field_polygon(field_points_x, field_points_y)));
 }
 
 void SwerveTrajectoryGenerator::wpt_keep_in_lane(
@@ -173,24 +286,10 @@ void SwerveTrajectoryGenerator::wpt_keep_in_lane(
 
 void SwerveTrajectoryGenerator::wpt_keep_out_circle(size_t index, double x,
                                                     double y, double radius) {
-  for (size_t bumper = 0; bumper < path_builder.get_bumpers().size();
-       bumper++) {
-    for (size_t i = 0; i < path_builder.get_bumpers().at(bumper).points.size();
-         i++) {
-      path_builder.wpt_constraint(
-          index, trajopt::PointPointMinConstraint{
-                     path_builder.get_bumpers().at(bumper).points.at(i),
-                     {x, y},
-                     radius});
-      path_builder.wpt_constraint(
-          index, trajopt::LinePointConstraint{
-                     path_builder.get_bumpers().at(bumper).points.at(i),
-                     path_builder.get_bumpers().at(bumper).points.at(
-                         (i + 1) %
-                         path_builder.get_bumpers().at(bumper).points.size()),
-                     {x, y},
-                     radius});
-    }
+  for (const auto& bumper : path_builder.get_bumpers()) {
+    path_builder.wpt_constraint(
+        index,
+        trajopt::KeepOutPolygonConstraint{bumper.points, {{x, y}}, radius});
   }
 }
 
@@ -255,25 +354,10 @@ void SwerveTrajectoryGenerator::sgmt_keep_in_polygon(
   if (field_points_x.size() != field_points_y.size()) {
     return;
   }
-  for (size_t i = 0; i < field_points_x.size(); i++) {
-    auto j = (i + 1) % field_points_x.size();
-    path_builder.sgmt_constraint(from_index, to_index,
-                                 trajopt::PointLineRegionConstraint{
-                                     {0.0, 0.0},
-                                     {field_points_x[i], field_points_y[i]},
-                                     {field_points_x[j], field_points_y[j]},
-                                     Side::ABOVE});
-    for (const auto& bumper : path_builder.get_bumpers()) {
-      for (const auto& corner : bumper.points) {
-        path_builder.sgmt_constraint(from_index, to_index,
-                                     trajopt::PointLineRegionConstraint{
-                                         corner,
-                                         {field_points_x[i], field_points_y[i]},
-                                         {field_points_x[j], field_points_y[j]},
-                                         Side::ABOVE});
-      }
-    }
-  }
+  path_builder.sgmt_constraint(
+      from_index, to_index,
+      path_builder.keep_in_polygon(
+          to_field_polygon(field_points_x, field_points_y)));
 }
 
 void SwerveTrajectoryGenerator::sgmt_keep_in_lane(
@@ -290,85 +374,34 @@ void SwerveTrajectoryGenerator::sgmt_keep_in_lane(
 void SwerveTrajectoryGenerator::sgmt_keep_out_circle(size_t from_index,
                                                      size_t to_index, double x,
                                                      double y, double radius) {
-  for (size_t bumper = 0; bumper < path_builder.get_bumpers().size();
-       bumper++) {
-    for (size_t i = 0; i < path_builder.get_bumpers().at(bumper).points.size();
-         i++) {
-      path_builder.sgmt_constraint(
-          from_index, to_index,
-          trajopt::PointPointMinConstraint{
-              path_builder.get_bumpers().at(bumper).points.at(i),
-              {x, y},
-              radius});
-      path_builder.sgmt_constraint(
-          from_index, to_index,
-          trajopt::LinePointConstraint{
-              path_builder.get_bumpers().at(bumper).points.at(i),
-              path_builder.get_bumpers().at(bumper).points.at(
-                  (i + 1) %
-                  path_builder.get_bumpers().at(bumper).points.size()),
-              {x, y},
-              radius});
-    }
+  for (const auto& bumper : path_builder.get_bumpers()) {
+    path_builder.sgmt_constraint(
+        from_index, to_index,
+        trajopt::KeepOutPolygonConstraint{bumper.points, {{x, y}}, radius});
   }
 }
 
 void SwerveTrajectoryGenerator::add_callback(
-    rust::Fn<void(SwerveTrajectory, int64_t)> callback) {
+    rust::Fn<void(SwerveTrajectory, int64_t)> callback, double max_rate) {
   path_builder.add_callback(
       [=](const trajopt::SwerveSolution& solution, int64_t handle) {
-        trajopt::SwerveTrajectory cpp_trajectory{solution};
-
-        rust::Vec<SwerveTrajectorySample> rust_samples;
-        for (const auto& cpp_sample : cpp_trajectory.samples) {
-          rust::Vec<double> fx;
-          std::copy(cpp_sample.module_forces_x.begin(),
-                    cpp_sample.module_forces_x.end(), std::back_inserter(fx));
-
-          rust::Vec<double> fy;
-          std::copy(cpp_sample.module_forces_y.begin(),
-                    cpp_sample.module_forces_y.end(), std::back_inserter(fy));
-
-          rust_samples.push_back(SwerveTrajectorySample{
-              cpp_sample.timestamp, cpp_sample.x, cpp_sample.y,
-              cpp_sample.heading, cpp_sample.velocity_x, cpp_sample.velocity_y,
-              cpp_sample.angular_velocity, cpp_sample.acceleration_x,
-              cpp_sample.acceleration_y, cpp_sample.angular_acceleration,
-              std::move(fx), std::move(fy)});
-        }
-
-        callback(SwerveTrajectory{rust_samples}, handle);
-      });
+        callback(to_rust_trajectory(solution), handle);
+      },
+      max_rate);
 }
 
 SwerveTrajectory SwerveTrajectoryGenerator::generate(bool diagnostics,
                                                      int64_t handle) const {
-  trajopt::SwerveTrajectoryGenerator generator{path_builder, handle};
-  if (auto sol = generator.generate(diagnostics); sol.has_value()) {
-    trajopt::SwerveTrajectory cpp_trajectory{sol.value()};
-
-    rust::Vec<SwerveTrajectorySample> rust_samples;
-    for (const auto& cpp_sample : cpp_trajectory.samples) {
-      rust::Vec<double> fx;
-      std::copy(cpp_sample.module_forces_x.begin(),
-                cpp_sample.module_forces_x.end(), std::back_inserter(fx));
-
-      rust::Vec<double> fy;
-      std::copy(cpp_sample.module_forces_y.begin(),
-                cpp_sample.module_forces_y.end(), std::back_inserter(fy));
-
-      rust_samples.push_back(SwerveTrajectorySample{
-          cpp_sample.timestamp, cpp_sample.x, cpp_sample.y, cpp_sample.heading,
-          cpp_sample.velocity_x, cpp_sample.velocity_y,
-          cpp_sample.angular_velocity, cpp_sample.acceleration_x,
-          cpp_sample.acceleration_y, cpp_sample.angular_acceleration,
-          std::move(fx), std::move(fy)});
-    }
+  trajopt::SolveOptions options;
+  options.diagnostics = diagnostics;
+  return generate_trajectory<trajopt::SwerveTrajectoryGenerator>(
+      path_builder, options, handle);
+}
 
-    return SwerveTrajectory{std::move(rust_samples)};
-  } else {
-    throw sol.error();
-  }
+SwerveTrajectory SwerveTrajectoryGenerator::generate_with_options(
+    const SolveOptions& options, int64_t handle) const {
+  return generate_trajectory<trajopt::SwerveTrajectoryGenerator>(
+      path_builder, to_cpp_options(options), handle);
 }
 
 std::unique_ptr<SwerveTrajectoryGenerator> swerve_trajectory_generator_new() {
@@ -488,25 +521,9 @@ void DifferentialTrajectoryGenerator::wpt_keep_in_polygon(
   if (field_points_x.size() != field_points_y.size()) {
     return;
   }
-  for (size_t i = 0; i < field_points_x.size(); i++) {
-    auto j = (i + 1) % field_points_x.size();
-    path_builder.wpt_constraint(index,
-                                trajopt::PointLineRegionConstraint{
-                                    {0.0, 0.0},
-                                    {field_points_x[i], field_points_y[i]},
-                                    {field_points_x[j], field_points_y[j]},
-                                    Side::ABOVE});
-    for (const auto& bumper : path_builder.get_bumpers()) {
-      for (const auto& corner : bumper.points) {
-        path_builder.wpt_constraint(index,
-                                    trajopt::PointLineRegionConstraint{
-                                        corner,
-                                        {field_points_x[i], field_points_y[i]},
-                                        {field_points_x[j], field_points_y[j]},
-                                        Side::ABOVE});
-      }
-    }
-  }
+  path_builder.wpt_constraint(
+      index, path_builder.keep_in_polygon(
+                 to_field_polygon(field_points_x, field_points_y)));
 }
 
 void DifferentialTrajectoryGenerator::wpt_keep_in_lane(
@@ -521,24 +538,10 @@ void DifferentialTrajectoryGenerator::wpt_keep_in_lane(
 void DifferentialTrajectoryGenerator::wpt_keep_out_circle(size_t index,
                                                           double x, double y,
                                                           double radius) {
-  for (size_t bumper = 0; bumper < path_builder.get_bumpers().size();
-       bumper++) {
-    for (size_t i = 0; i < path_builder.get_bumpers().at(bumper).points.size();
-         i++) {
-      path_builder.wpt_constraint(
-          index, trajopt::PointPointMinConstraint{
-                     path_builder.get_bumpers().at(bumper).points.at(i),
-                     {x, y},
-                     radius});
-      path_builder.wpt_constraint(
-          index, trajopt::LinePointConstraint{
-                     path_builder.get_bumpers().at(bumper).points.at(i),
-                     path_builder.get_bumpers().at(bumper).points.at(
-                         (i + 1) %
-                         path_builder.get_bumpers().at(bumper).points.size()),
-                     {x, y},
-                     radius});
-    }
+  for (const auto& bumper : path_builder.get_bumpers()) {
+    path_builder.wpt_constraint(
+        index,
+        trajopt::KeepOutPolygonConstraint{bumper.points, {{x, y}}, radius});
   }
 }
 
@@ -592,25 +595,10 @@ void DifferentialTrajectoryGenerator::sgmt_keep_in_polygon(
   if (field_points_x.size() != field_points_y.size()) {
     return;
   }
-  for (size_t i = 0; i < field_points_x.size(); i++) {
-    auto j = (i + 1) % field_points_x.size();
-    path_builder.sgmt_constraint(from_index, to_index,
-                                 trajopt::PointLineRegionConstraint{
-                                     {0.0, 0.0},
-                                     {field_points_x[i], field_points_y[i]},
-                                     {field_points_x[j], field_points_y[j]},
-                                     Side::ABOVE});
-    for (const auto& bumper : path_builder.get_bumpers()) {
-      for (const auto& corner : bumper.points) {
-        path_builder.sgmt_constraint(from_index, to_index,
-                                     trajopt::PointLineRegionConstraint{
-                                         corner,
-                                         {field_points_x[i], field_points_y[i]},
-                                         {field_points_x[j], field_points_y[j]},
-                                         Side::ABOVE});
-      }
-    }
-  }
+  path_builder.sgmt_constraint(
+      from_index, to_index,
+      path_builder.keep_in_polygon(
+          to_field_polygon(field_points_x, field_points_y)));
 }
 
 void DifferentialTrajectoryGenerator::sgmt_keep_in_lane(
@@ -628,67 +616,35 @@ void DifferentialTrajectoryGenerator::sgmt_keep_out_circle(size_t from_index,
                                                            size_t to_index,
                                                            double x, double y,
                                                            double radius) {
-  for (size_t bumper = 0; bumper < path_builder.get_bumpers().size();
-       bumper++) {
-    for (size_t i = 0; i < path_builder.get_bumpers().at(bumper).points.size();
-         i++) {
-      path_builder.sgmt_constraint(
-          from_index, to_index,
-          trajopt::PointPointMinConstraint{
-              path_builder.get_bumpers().at(bumper).points.at(i),
-              {x, y},
-              radius});
-      path_builder.sgmt_constraint(
-          from_index, to_index,
-          trajopt::LinePointConstraint{
-              path_builder.get_bumpers().at(bumper).points.at(i),
-              path_builder.get_bumpers().at(bumper).points.at(
-                  (i + 1) %
-                  path_builder.get_bumpers().at(bumper).points.size()),
-              {x, y},
-              radius});
-    }
+  for (const auto& bumper : path_builder.get_bumpers()) {
+    path_builder.sgmt_constraint(
+        from_index, to_index,
+        trajopt::KeepOutPolygonConstraint{bumper.points, {{x, y}}, radius});
   }
 }
 
 void DifferentialTrajectoryGenerator::add_callback(
-    rust::Fn<void(DifferentialTrajectory, int64_t)> callback) {
-  path_builder.add_callback([=](const trajopt::DifferentialSolution& solution,
-                                int64_t handle) {
-    trajopt::DifferentialTrajectory cpp_trajectory{solution};
-
-    rust::Vec<DifferentialTrajectorySample> rust_samples;
-    for (const auto& cpp_sample : cpp_trajectory.samples) {
-      rust_samples.push_back(DifferentialTrajectorySample{
-          cpp_sample.timestamp, cpp_sample.x, cpp_sample.y, cpp_sample.heading,
-          cpp_sample.velocity_l, cpp_sample.velocity_r,
-          cpp_sample.angular_velocity, cpp_sample.acceleration_l,
-          cpp_sample.acceleration_r, cpp_sample.force_l, cpp_sample.force_r});
-    }
-
-    callback(DifferentialTrajectory{rust_samples}, handle);
-  });
+    rust::Fn<void(DifferentialTrajectory, int64_t)> callback,
+    double max_rate) {
+  path_builder.add_callback(
+      [=](const trajopt::DifferentialSolution& solution, int64_t handle) {
+        callback(to_rust_trajectory(solution), handle);
+      },
+      max_rate);
 }
 
 DifferentialTrajectory DifferentialTrajectoryGenerator::generate(
     bool diagnostics, int64_t handle) const {
-  trajopt::DifferentialTrajectoryGenerator generator{path_builder, handle};
-  if (auto sol = generator.generate(diagnostics); sol.has_value()) {
-    trajopt::DifferentialTrajectory cpp_trajectory{sol.value()};
-
-    rust::Vec<DifferentialTrajectorySample> rust_samples;
-    for (const auto& cpp_sample : cpp_trajectory.samples) {
-      rust_samples.push_back(DifferentialTrajectorySample{
-          cpp_sample.timestamp, cpp_sample.x, cpp_sample.y, cpp_sample.heading,
-          cpp_sample.velocity_l, cpp_sample.velocity_r,
-          cpp_sample.angular_velocity, cpp_sample.acceleration_l,
-          cpp_sample.acceleration_r, cpp_sample.force_l, cpp_sample.force_r});
-    }
+  trajopt::SolveOptions options;
+  options.diagnostics = diagnostics;
+  return generate_trajectory<trajopt::DifferentialTrajectoryGenerator>(
+      path_builder, options, handle);
+}
 
-    return DifferentialTrajectory{std::move(rust_samples)};
-  } else {
-    throw sol.error();
-  }
+DifferentialTrajectory DifferentialTrajectoryGenerator::generate_with_options(
+    const SolveOptions& options, int64_t handle) const {
+  return generate_trajectory<trajopt::DifferentialTrajectoryGenerator>(
+      path_builder, to_cpp_options(options), handle);
 }
 
 std::unique_ptr<DifferentialTrajectoryGenerator>
@@ -696,8 +652,17 @@ differential_trajectory_generator_new() {
   return std::make_unique<DifferentialTrajectoryGenerator>();
 }
 
+void cancel(int64_t handle) {
+  std::scoped_lock lock{running_tokens_mutex};
+  for (auto& [running_handle, token] : running_tokens) {
+    if (running_handle == handle) {
+      token.cancel();
+    }
+  }
+}
+
 void cancel_all() {
-  trajopt::get_cancellation_flag() = 1;
+  trajopt::cancel_all();
 }
 
 }  // namespace trajopt::rsffi
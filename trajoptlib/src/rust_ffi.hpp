@@ -32,6 +32,7 @@ struct DifferentialTrajectory;
 struct Pose2d;
 struct SwerveDrivetrain;
 struct DifferentialDrivetrain;
+struct SolveOptions;
 
 class SwerveTrajectoryGenerator {
  public:
@@ -96,7 +97,10 @@ class SwerveTrajectoryGenerator {
   /// @param callback A `fn` (not a closure) to be executed. The callback's
   ///     first parameter will be a `trajopt::SwerveTrajectory`, and the second
   ///     parameter will be an `i64` equal to the handle passed in `generate()`.
-  void add_callback(rust::Fn<void(SwerveTrajectory, int64_t)> callback);
+  /// @param max_rate The maximum rate at which the callback is called (Hz).
+  ///     Infinity calls it on every iteration, and zero disables it.
+  void add_callback(rust::Fn<void(SwerveTrajectory, int64_t)> callback,
+                    double max_rate);
 
   // TODO: Return std::expected<SwerveTrajectory, slp::SolverExitCondition>
   // instead of throwing exception, once cxx supports it
@@ -104,6 +108,13 @@ class SwerveTrajectoryGenerator {
   // https://github.com/dtolnay/cxx/issues/1052
   SwerveTrajectory generate(bool diagnostics = false, int64_t handle = 0) const;
 
+  /// Generates the trajectory with the given solver options.
+  ///
+  /// @param options The solver options.
+  /// @param handle An identifier for state callbacks.
+  SwerveTrajectory generate_with_options(const SolveOptions& options,
+                                         int64_t handle = 0) const;
+
  private:
   trajopt::SwervePathBuilder path_builder;
 };
@@ -172,7 +183,10 @@ class DifferentialTrajectoryGenerator {
   ///     first parameter will be a `trajopt::DifferentialTrajectory`, and the
   ///     second parameter will be an `i64` equal to the handle passed in
   ///     `generate()`.
-  void add_callback(rust::Fn<void(DifferentialTrajectory, int64_t)> callback);
+  /// @param max_rate The maximum rate at which the callback is called (Hz).
+  ///     Infinity calls it on every iteration, and zero disables it.
+  void add_callback(rust::Fn<void(DifferentialTrajectory, int64_t)> callback,
+                    double max_rate);
 
   // TODO: Return std::expected<DifferentialTrajectory,
   // slp::SolverExitCondition> instead of throwing exception, once cxx supports
@@ -182,6 +196,13 @@ class DifferentialTrajectoryGenerator {
   DifferentialTrajectory generate(bool diagnostics = false,
                                   int64_t handle = 0) const;
 
+  /// Generates the trajectory with the given solver options.
+  ///
+  /// @param options The solver options.
+  /// @param handle An identifier for state callbacks.
+  DifferentialTrajectory generate_with_options(const SolveOptions& options,
+                                               int64_t handle = 0) const;
+
  private:
   trajopt::DifferentialPathBuilder path_builder;
 };
@@ -191,6 +212,8 @@ std::unique_ptr<SwerveTrajectoryGenerator> swerve_trajectory_generator_new();
 std::unique_ptr<DifferentialTrajectoryGenerator>
 differential_trajectory_generator_new();
 
+void cancel(int64_t handle);
+
 void cancel_all();
 
 }  // namespace trajopt::rsffi
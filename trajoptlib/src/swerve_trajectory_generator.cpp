@@ -5,8 +5,14 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <future>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include <sleipnir/optimization/problem.hpp>
@@ -14,6 +20,12 @@
 
 #include "trajopt/geometry/rotation2.hpp"
 #include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/coarse_to_fine.hpp"
+#include "trajopt/util/constraint_report.hpp"
+#include "trajopt/util/lazy_keep_outs.hpp"
+#include "trajopt/util/segment_layout.hpp"
+#include "trajopt/util/simplify_constraints.hpp"
+#include "trajopt/util/split_path.hpp"
 #include "trajopt/util/trajopt_util.hpp"
 
 // Physics notation in this file:
@@ -33,37 +45,62 @@
 namespace trajopt {
 
 SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
-    SwervePathBuilder path_builder, int64_t handle)
-    : path(path_builder.get_path()),
-      Ns(path_builder.get_control_interval_counts()) {
+    SwervePathBuilder path_builder, int64_t handle,
+    CancellationToken cancellation_token)
+    : path_builder(path_builder),
+      handle(handle),
+      path(path_builder.get_path()),
+      layout(path_builder.get_control_interval_counts()),
+      cancellation_token(std::move(cancellation_token)) {
+  removed_constraint_count =
+      simplify_constraints(path, path_builder.get_control_interval_counts());
+
+  // Precompute constant constraint geometry once instead of once per sample,
+  // and bind waypoint targets to parameters so set_waypoint_pose() can move
+  // them without rebuilding the problem
+  for (auto& waypoint : path.waypoints) {
+    for (auto& constraint : waypoint.waypoint_constraints) {
+      bind_target_parameters(constraint);
+      prepare_constraint(constraint);
+    }
+    for (auto& constraint : waypoint.segment_constraints) {
+      prepare_constraint(constraint);
+    }
+  }
+
   auto initial_guess = path_builder.calculate_linear_initial_guess();
 
+  callback_times.resize(path.callbacks.size());
   problem.add_callback(
       [this, handle = handle](const slp::IterationInfo<double>&) -> bool {
-        constexpr int fps = 60;
-        constexpr std::chrono::duration<double> time_per_frame{1.0 / fps};
-
-        // FPS limit on sending updates
-        static auto last_frame_time = std::chrono::steady_clock::now();
+        // Rate limit on sending updates. The snapshot is only updated if at
+        // least one callback is due.
         auto now = std::chrono::steady_clock::now();
-        if (now - last_frame_time < time_per_frame) {
-          return trajopt::get_cancellation_flag();
+        bool snapshot_updated = false;
+        for (size_t i = 0; i < this->path.callbacks.size(); ++i) {
+          const auto& callback = this->path.callbacks[i];
+          if (!callback.is_due(now, callback_times[i])) {
+            continue;
+          }
+
+          if (!snapshot_updated) {
+            update_snapshot();
+            snapshot_updated = true;
+          }
+          callback_times[i] = now;
+          callback.function(snapshot, handle);
         }
 
-        last_frame_time = now;
-
-        auto soln = construct_swerve_solution();
-        for (auto& callback : this->path.callbacks) {
-          callback(soln, handle);
-        }
-
-        return trajopt::get_cancellation_flag();
+        return this->cancellation_token.is_cancelled();
       });
 
-  size_t wpt_cnt = path.waypoints.size();
-  size_t sgmt_cnt = path.waypoints.size() - 1;
-  size_t samp_tot = get_index(Ns, wpt_cnt - 1, 0) + 1;
+  size_t wpt_cnt = layout.waypoint_count();
+  size_t sgmt_cnt = layout.segment_count();
+  size_t samp_tot = layout.sample_count();
   size_t module_cnt = path.drivetrain.modules.size();
+  const bool eliminate_accelerations =
+      path_builder.get_eliminate_accelerations();
+  const bool share_segment_dt = path_builder.get_share_segment_dt();
 
   x.reserve(samp_tot);
   y.reserve(samp_tot);
@@ -76,14 +113,8 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
   ay.reserve(samp_tot);
   α.reserve(samp_tot);
 
-  Fx.reserve(samp_tot);
-  Fy.reserve(samp_tot);
-  for (size_t sample_index = 0; sample_index < samp_tot; ++sample_index) {
-    auto& _Fx = Fx.emplace_back();
-    auto& _Fy = Fy.emplace_back();
-    _Fx.reserve(module_cnt);
-    _Fy.reserve(module_cnt);
-  }
+  Fx.resize(samp_tot, module_cnt);
+  Fy.resize(samp_tot, module_cnt);
 
   dts.reserve(samp_tot);
 
@@ -95,18 +126,76 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     vx.emplace_back(problem.decision_variable());
     vy.emplace_back(problem.decision_variable());
     ω.emplace_back(problem.decision_variable());
-    ax.emplace_back(problem.decision_variable());
-    ay.emplace_back(problem.decision_variable());
-    α.emplace_back(problem.decision_variable());
+    if (!eliminate_accelerations) {
+      ax.emplace_back(problem.decision_variable());
+      ay.emplace_back(problem.decision_variable());
+      α.emplace_back(problem.decision_variable());
+    }
 
     for (size_t module_index = 0; module_index < module_cnt; ++module_index) {
-      Fx.at(index).emplace_back(problem.decision_variable());
-      Fy.at(index).emplace_back(problem.decision_variable());
+      Fx[index][module_index] = problem.decision_variable();
+      Fy[index][module_index] = problem.decision_variable();
     }
 
+    if (!share_segment_dt) {
+      dts.emplace_back(problem.decision_variable());
+    }
+  }
+
+  // With shared time steps, each segment's intervals all reference one time
+  // step variable, and the final sample keeps its own
+  if (share_segment_dt) {
+    for (size_t sgmt_index = 0; sgmt_index < sgmt_cnt; ++sgmt_index) {
+      if (layout.interval_count(sgmt_index) == 0) {
+        continue;
+      }
+
+      auto dt = problem.decision_variable();
+      for (size_t index = layout.start(sgmt_index);
+           index < layout.end(sgmt_index); ++index) {
+        dts.emplace_back(dt);
+      }
+    }
     dts.emplace_back(problem.decision_variable());
   }
 
+  // Net force and torque on the robot at a sample
+  auto net_wrench = [&](size_t index) {
+    Rotation2v<double> θ_k{cosθ.at(index), sinθ.at(index)};
+
+    auto Fx_net =
+        std::accumulate(Fx[index].begin(), Fx[index].end(), slp::Variable{0.0});
+    auto Fy_net =
+        std::accumulate(Fy[index].begin(), Fy[index].end(), slp::Variable{0.0});
+
+    slp::Variable τ_net = 0.0;
+    for (size_t module_index = 0; module_index < module_cnt; ++module_index) {
+      const auto& translation = path.drivetrain.modules.at(module_index);
+      auto r = translation.rotate_by(θ_k);
+      Translation2v<double> F{Fx[index][module_index],
+                              Fy[index][module_index]};
+
+      τ_net += r.cross(F);
+    }
+
+    return std::array{std::move(Fx_net), std::move(Fy_net), std::move(τ_net)};
+  };
+
+  // In the reduced formulation, the accelerations are the dynamics solved for
+  // them instead of decision variables
+  //
+  //   a_xₖ = ΣF_xₖ/m
+  //   a_yₖ = ΣF_yₖ/m
+  //   αₖ = Στₖ/J
+  if (eliminate_accelerations) {
+    for (size_t index = 0; index < samp_tot; ++index) {
+      auto [Fx_net, Fy_net, τ_net] = net_wrench(index);
+      ax.emplace_back(Fx_net / path.drivetrain.mass);
+      ay.emplace_back(Fy_net / path.drivetrain.mass);
+      α.emplace_back(τ_net / path.drivetrain.moi);
+    }
+  }
+
   double min_width = INFINITY;
   for (size_t i = 0; i < path.drivetrain.modules.size(); ++i) {
     auto mod_a = path.drivetrain.modules.at(i);
@@ -129,17 +218,18 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
           .norm();
   const double chassis_max_ω = chassis_max_v / wheel_max_position_radius;
   const double chassis_max_α = chassis_max_a / wheel_max_position_radius;
-  for (size_t sgmt_index = 0; sgmt_index < Ns.size(); ++sgmt_index) {
-    size_t N_sgmt = Ns.at(sgmt_index);
-    size_t sgmt_start = get_index(Ns, sgmt_index);
-    size_t sgmt_end = get_index(Ns, sgmt_index + 1);
+  for (size_t sgmt_index = 0; sgmt_index < sgmt_cnt; ++sgmt_index) {
+    size_t N_sgmt = layout.interval_count(sgmt_index);
+    size_t sgmt_start = layout.start(sgmt_index);
+    size_t sgmt_end = layout.end(sgmt_index);
 
     if (N_sgmt == 0) {
       for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
         dts.at(index).set_value(0.0);
       }
     } else {
-      // Use initial_guess and Ns to find the dx, dy, dθ between wpts
+      // Use initial_guess and the segment layout to find the dx, dy, dθ
+      // between wpts
       const double dx =
           initial_guess.x.at(sgmt_end) - initial_guess.x.at(sgmt_start);
       const double dy =
@@ -159,7 +249,10 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
 
       for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
         auto& dt = dts.at(index);
-        problem.subject_to(slp::bounds(0, dt, 3));
+        // Shared time steps are bounded once instead of at every sample
+        if (!share_segment_dt || index == sgmt_start || index + 1 == samp_tot) {
+          problem.subject_to(slp::bounds(0, dt, 3));
+        }
         dt.set_value(sgmt_time / N_sgmt);
       }
     }
@@ -167,11 +260,12 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
   problem.minimize(std::accumulate(dts.begin(), dts.end(), slp::Variable{0.0}));
 
   // Apply kinematics constraints
-  for (size_t wpt_index = 0; wpt_index < wpt_cnt - 1; ++wpt_index) {
-    size_t N_sgmt = Ns.at(wpt_index);
+  const auto transcription_method = path_builder.get_transcription_method();
+  for (size_t wpt_index = 0; wpt_index < sgmt_cnt; ++wpt_index) {
+    size_t N_sgmt = layout.interval_count(wpt_index);
 
     for (size_t sample_index = 0; sample_index < N_sgmt; ++sample_index) {
-      size_t index = get_index(Ns, wpt_index, sample_index);
+      size_t index = layout.index(wpt_index, sample_index);
 
       Translation2v<double> x_k{x.at(index), y.at(index)};
       Translation2v<double> x_k_1{x.at(index + 1), y.at(index + 1)};
@@ -192,21 +286,64 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
       auto α_k_1 = α.at(index + 1);
 
       auto dt_k = dts.at(index);
-      if (sample_index < N_sgmt - 1) {
+      if (!share_segment_dt && sample_index < N_sgmt - 1) {
         auto dt_k_1 = dts.at(index + 1);
         problem.subject_to(dt_k_1 == dt_k);
       }
 
-      // xₖ₊₁ = xₖ + vₖt + 1/2aₖt²
-      // θₖ₊₁ = θₖ + ωₖt + 1/2αₖt²
-      // vₖ₊₁ = vₖ + aₖt
-      // ωₖ₊₁ = ωₖ + αₖt
-      problem.subject_to(x_k_1 == x_k + v_k * dt_k + a_k * 0.5 * dt_k * dt_k);
-      problem.subject_to(θ_k_1 ==
-                         θ_k + Rotation2v<double>{ω_k * dt_k} +
-                             Rotation2v<double>{α_k * 0.5 * dt_k * dt_k});
-      problem.subject_to(v_k_1 == v_k + a_k * dt_k);
-      problem.subject_to(ω_k_1 == ω_k + α_k * dt_k);
+      switch (transcription_method) {
+        case TranscriptionMethod::DEFAULT:
+          // xₖ₊₁ = xₖ + vₖt + 1/2aₖt²
+          // θₖ₊₁ = θₖ + ωₖt + 1/2αₖt²
+          // vₖ₊₁ = vₖ + aₖt
+          // ωₖ₊₁ = ωₖ + αₖt
+          problem.subject_to(x_k_1 ==
+                             x_k + v_k * dt_k + a_k * 0.5 * dt_k * dt_k);
+          problem.subject_to(θ_k_1 ==
+                             θ_k + Rotation2v<double>{ω_k * dt_k} +
+                                 Rotation2v<double>{α_k * 0.5 * dt_k * dt_k});
+          problem.subject_to(v_k_1 == v_k + a_k * dt_k);
+          problem.subject_to(ω_k_1 == ω_k + α_k * dt_k);
+          break;
+        case TranscriptionMethod::EXPLICIT_EULER:
+          // xₖ₊₁ = xₖ + vₖt
+          // θₖ₊₁ = θₖ + ωₖt
+          // vₖ₊₁ = vₖ + aₖt
+          // ωₖ₊₁ = ωₖ + αₖt
+          problem.subject_to(x_k_1 == x_k + v_k * dt_k);
+          problem.subject_to(θ_k_1 == θ_k + Rotation2v<double>{ω_k * dt_k});
+          problem.subject_to(v_k_1 == v_k + a_k * dt_k);
+          problem.subject_to(ω_k_1 == ω_k + α_k * dt_k);
+          break;
+        case TranscriptionMethod::TRAPEZOIDAL:
+          // xₖ₊₁ = xₖ + 1/2(vₖ + vₖ₊₁)t
+          // θₖ₊₁ = θₖ + 1/2(ωₖ + ωₖ₊₁)t
+          // vₖ₊₁ = vₖ + 1/2(aₖ + aₖ₊₁)t
+          // ωₖ₊₁ = ωₖ + 1/2(αₖ + αₖ₊₁)t
+          problem.subject_to(x_k_1 == x_k + (v_k + v_k_1) * 0.5 * dt_k);
+          problem.subject_to(
+              θ_k_1 == θ_k + Rotation2v<double>{(ω_k + ω_k_1) * 0.5 * dt_k});
+          problem.subject_to(v_k_1 == v_k + (a_k + a_k_1) * 0.5 * dt_k);
+          problem.subject_to(ω_k_1 == ω_k + (α_k + α_k_1) * 0.5 * dt_k);
+          break;
+        case TranscriptionMethod::HERMITE_SIMPSON:
+          // With the acceleration interpolated linearly, Simpson's rule on the
+          // cubic Hermite velocity gives
+          //
+          //   xₖ₊₁ = xₖ + 1/2(vₖ + vₖ₊₁)t + 1/12(aₖ − aₖ₊₁)t²
+          //   θₖ₊₁ = θₖ + 1/2(ωₖ + ωₖ₊₁)t + 1/12(αₖ − αₖ₊₁)t²
+          //   vₖ₊₁ = vₖ + 1/2(aₖ + aₖ₊₁)t
+          //   ωₖ₊₁ = ωₖ + 1/2(αₖ + αₖ₊₁)t
+          problem.subject_to(x_k_1 == x_k + (v_k + v_k_1) * 0.5 * dt_k +
+                                          (a_k - a_k_1) * (dt_k * dt_k / 12.0));
+          problem.subject_to(
+              θ_k_1 ==
+              θ_k + Rotation2v<double>{(ω_k + ω_k_1) * 0.5 * dt_k +
+                                       (α_k - α_k_1) * (dt_k * dt_k / 12.0)});
+          problem.subject_to(v_k_1 == v_k + (a_k + a_k_1) * 0.5 * dt_k);
+          problem.subject_to(ω_k_1 == ω_k + (α_k + α_k_1) * 0.5 * dt_k);
+          break;
+      }
     }
   }
 
@@ -214,24 +351,6 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     Rotation2v<double> θ_k{cosθ.at(index), sinθ.at(index)};
     Translation2v<double> v_k{vx.at(index), vy.at(index)};
 
-    // Solve for net force
-    auto Fx_net = std::accumulate(Fx.at(index).begin(), Fx.at(index).end(),
-                                  slp::Variable{0.0});
-    auto Fy_net = std::accumulate(Fy.at(index).begin(), Fy.at(index).end(),
-                                  slp::Variable{0.0});
-
-    // Solve for net torque
-    slp::Variable τ_net = 0.0;
-    for (size_t module_index = 0; module_index < path.drivetrain.modules.size();
-         ++module_index) {
-      const auto& translation = path.drivetrain.modules.at(module_index);
-      auto r = translation.rotate_by(θ_k);
-      Translation2v<double> F{Fx.at(index).at(module_index),
-                              Fy.at(index).at(module_index)};
-
-      τ_net += r.cross(F);
-    }
-
     // Apply module power constraints
     auto v_wrt_robot = v_k.rotate_by(-θ_k);
     for (size_t module_index = 0; module_index < path.drivetrain.modules.size();
@@ -247,8 +366,8 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
       // |v|₂² ≤ vₘₐₓ²
       problem.subject_to(v_wheel_wrt_robot.squared_norm() <= v_max * v_max);
 
-      Translation2v<double> module_force{Fx.at(index).at(module_index),
-                                         Fy.at(index).at(module_index)};
+      Translation2v<double> module_force{Fx[index][module_index],
+                                         Fy[index][module_index]};
 
       // τ = r x F
       // F = τ/r
@@ -272,59 +391,96 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     //   ΣF_xₖ = ma_xₖ
     //   ΣF_yₖ = ma_yₖ
     //   Στₖ = Jαₖ
-    problem.subject_to(Fx_net == path.drivetrain.mass * ax.at(index));
-    problem.subject_to(Fy_net == path.drivetrain.mass * ay.at(index));
-    problem.subject_to(τ_net == path.drivetrain.moi * α.at(index));
+    if (!eliminate_accelerations) {
+      auto [Fx_net, Fy_net, τ_net] = net_wrench(index);
+      problem.subject_to(Fx_net == path.drivetrain.mass * ax.at(index));
+      problem.subject_to(Fy_net == path.drivetrain.mass * ay.at(index));
+      problem.subject_to(τ_net == path.drivetrain.moi * α.at(index));
+    }
   }
 
-  for (size_t wpt_index = 0; wpt_index < wpt_cnt; ++wpt_index) {
-    // First index of next wpt - 1
-    size_t index = get_index(Ns, wpt_index, 0);
+  // Constraints may seed auxiliary variables from the initial guess, so apply
+  // it first
+  apply_initial_guess(initial_guess);
 
-    Pose2v<double> pose_k{
-        x.at(index), y.at(index), {cosθ.at(index), sinθ.at(index)}};
-    Translation2v<double> v_k{vx.at(index), vy.at(index)};
-    auto ω_k = ω.at(index);
-    Translation2v<double> a_k{ax.at(index), ay.at(index)};
-    auto α_k = α.at(index);
+  // Keep-out constraints are deferred to the first solve, which decides which
+  // samples need them
+  auto apply_or_defer = [&](size_t index, Constraint& constraint) {
+    if (std::holds_alternative<KeepOutPolygonConstraint>(constraint)) {
+      inactive_keep_outs.emplace_back(index, constraint);
+    } else {
+      apply_constraint(index, constraint);
+    }
+  };
 
+  for (size_t wpt_index = 0; wpt_index < wpt_cnt; ++wpt_index) {
     for (auto& constraint : path.waypoints.at(wpt_index).waypoint_constraints) {
-      std::visit(
-          [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
-          constraint);
+      apply_or_defer(layout.index(wpt_index), constraint);
     }
   }
 
   for (size_t sgmt_index = 0; sgmt_index < sgmt_cnt; ++sgmt_index) {
-    size_t start_index = get_index(Ns, sgmt_index, 0);
-    size_t end_index = get_index(Ns, sgmt_index + 1, 0);
+    size_t start_index = layout.start(sgmt_index);
+    size_t end_index = layout.end(sgmt_index);
 
     for (size_t index = start_index; index < end_index; ++index) {
-      Pose2v<double> pose_k{
-          x.at(index), y.at(index), {cosθ.at(index), sinθ.at(index)}};
-      Translation2v<double> v_k{vx.at(index), vy.at(index)};
-      auto ω_k = ω.at(index);
-      Translation2v<double> a_k{ax.at(index), ay.at(index)};
-      auto α_k = α.at(index);
-
       for (auto& constraint :
            path.waypoints.at(sgmt_index + 1).segment_constraints) {
-        std::visit(
-            [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
-            constraint);
+        apply_or_defer(index, constraint);
       }
     }
   }
-
-  apply_initial_guess(initial_guess);
 }
 
 std::expected<SwerveSolution, slp::ExitStatus>
 SwerveTrajectoryGenerator::generate(bool diagnostics) {
-  get_cancellation_flag() = 0;
+  SolveOptions options;
+  options.diagnostics = diagnostics;
+  return generate(options);
+}
+
+std::expected<SwerveSolution, slp::ExitStatus>
+SwerveTrajectoryGenerator::generate(const SolveOptions& options) {
+  if (options.split_at_stops &&
+      can_split_at_stops(path_builder.get_transcription_method()) &&
+      !has_user_constraints(path_builder.get_path())) {
+    // Simplification may have removed a stop's constraints in favor of the
+    // following segment's, so look for stops in the path as given
+    if (auto split_wpts = find_split_waypoints(path_builder.get_path());
+        !split_wpts.empty()) {
+      return solve_split(split_wpts, options);
+    }
+  }
 
-  // tolerance of 1e-4 is 0.1 mm
-  auto status = problem.solve({.tolerance = 1e-4, .diagnostics = diagnostics});
+  if (options.coarse_to_fine_levels.empty()) {
+    return solve(options);
+  }
+
+  const auto start_time = std::chrono::steady_clock::now();
+  if (auto warm_start = solve_coarse_to_fine_levels<SwerveTrajectoryGenerator>(
+          path_builder, handle, cancellation_token, options)) {
+    apply_warm_start(warm_start.value());
+  }
+
+  auto full_options = options;
+  full_options.timeout =
+      std::max<std::chrono::duration<double>>(
+          options.timeout - (std::chrono::steady_clock::now() - start_time),
+          std::chrono::duration<double>{0.0});
+  return solve(full_options);
+}
+
+std::expected<SwerveSolution, slp::ExitStatus>
+SwerveTrajectoryGenerator::solve(const SolveOptions& options) {
+  auto status = solve_with_lazy_keep_outs(
+      problem, options,
+      [&](double distance) { return activate_keep_outs(distance); });
+
+  if (options.return_last_iterate_on_limit &&
+      (status == slp::ExitStatus::MAX_ITERATIONS_EXCEEDED ||
+       status == slp::ExitStatus::TIMEOUT)) {
+    return construct_swerve_solution();
+  }
 
   if (static_cast<int>(status) < 0 ||
       status == slp::ExitStatus::CALLBACK_REQUESTED_STOP) {
@@ -334,6 +490,172 @@ SwerveTrajectoryGenerator::generate(bool diagnostics) {
   }
 }
 
+std::expected<SwerveSolution, slp::ExitStatus>
+SwerveTrajectoryGenerator::solve_split(const std::vector<size_t>& split_wpts,
+                                       const SolveOptions& options) {
+  auto sub_options = options;
+  sub_options.split_at_stops = false;
+
+  // Each sub-path runs from one split waypoint to the next
+  std::vector<size_t> bounds{0};
+  bounds.insert(bounds.end(), split_wpts.begin(), split_wpts.end());
+  bounds.push_back(path.waypoints.size() - 1);
+
+  std::vector<std::future<std::expected<SwerveSolution, slp::ExitStatus>>>
+      sub_solves;
+  sub_solves.reserve(bounds.size() - 1);
+  for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+    auto sub_builder = path_builder.sub_path(bounds[i], bounds[i + 1]);
+    sub_builder.get_path().callbacks.clear();
+
+    // Sub-paths are built concurrently, and a Parameter's variable isn't safe
+    // to share across threads, so each gets its Parameters' current values
+    for (auto& waypoint : sub_builder.get_path().waypoints) {
+      for (auto& constraint : waypoint.waypoint_constraints) {
+        unbind_parameters(constraint);
+      }
+      for (auto& constraint : waypoint.segment_constraints) {
+        unbind_parameters(constraint);
+      }
+    }
+
+    sub_solves.push_back(std::async(
+        std::launch::async,
+        [this, &sub_options](SwervePathBuilder sub_builder) {
+          SwerveTrajectoryGenerator generator{std::move(sub_builder), handle,
+                                              cancellation_token};
+          return generator.generate(sub_options);
+        },
+        std::move(sub_builder)));
+  }
+
+  std::vector<SwerveSolution> sub_solutions;
+  std::optional<slp::ExitStatus> error;
+  for (auto& sub_solve : sub_solves) {
+    auto sub_solution = sub_solve.get();
+    if (sub_solution.has_value()) {
+      sub_solutions.push_back(std::move(sub_solution.value()));
+    } else if (!error) {
+      error = sub_solution.error();
+    }
+  }
+
+  if (error) {
+    return std::unexpected{error.value()};
+  }
+
+  // Seed this problem with the joined solution, so resolve() and
+  // constraint_report() start from it instead of the initial guess
+  auto joined = join_solutions(sub_solutions);
+  apply_warm_start(joined);
+  return joined;
+}
+
+std::expected<SwerveSolution, slp::ExitStatus>
+SwerveTrajectoryGenerator::generate(const SwerveSolution& warm_start,
+                                    const SolveOptions& options) {
+  apply_warm_start(warm_start);
+  return solve(options);
+}
+
+std::expected<SwerveSolution, slp::ExitStatus>
+SwerveTrajectoryGenerator::resolve(const SolveOptions& options) {
+  return solve(options);
+}
+
+void SwerveTrajectoryGenerator::set_waypoint_pose(size_t wpt_index,
+                                                 const Pose2d& pose) {
+  bool has_target = false;
+  bool has_heading = false;
+  for (auto& constraint : path.waypoints.at(wpt_index).waypoint_constraints) {
+    has_target |= set_target_pose(constraint, pose);
+    has_heading |= std::holds_alternative<PoseEqualityConstraint>(constraint);
+  }
+
+  // Keep the path builder's copy in sync, since coarse-to-fine levels are
+  // built from it
+  for (auto& constraint :
+       path_builder.get_path().waypoints.at(wpt_index).waypoint_constraints) {
+    set_target_pose(constraint, pose);
+  }
+
+  if (!has_target) {
+    return;
+  }
+
+  // Move the waypoint's sample onto the new target so the next solve starts
+  // from there
+  size_t index = layout.index(wpt_index);
+  x.at(index).set_value(pose.x());
+  y.at(index).set_value(pose.y());
+  if (has_heading) {
+    cosθ.at(index).set_value(pose.rotation().cos());
+    sinθ.at(index).set_value(pose.rotation().sin());
+  }
+}
+
+ConstraintReport SwerveTrajectoryGenerator::constraint_report(
+    double active_tolerance) {
+  std::vector<SampleState> states;
+  states.reserve(x.size());
+  for (size_t index = 0; index < x.size(); ++index) {
+    states.push_back(
+        {.pose = {x[index].value(),
+                  y[index].value(),
+                  {cosθ[index].value(), sinθ[index].value()}},
+         .linear_velocity = {vx[index].value(), vy[index].value()},
+         .angular_velocity = ω[index].value(),
+         .linear_acceleration = {ax[index].value(), ay[index].value()},
+         .angular_acceleration = α[index].value()});
+  }
+
+  auto report = evaluate_constraints(path_builder.get_path(), layout, states,
+                                     active_tolerance);
+  report.timing = constraint_timing;
+  report.removed_constraint_count = removed_constraint_count;
+  return report;
+}
+
+void SwerveTrajectoryGenerator::apply_constraint(size_t index,
+                                                 Constraint& constraint) {
+  Pose2v<double> pose_k{
+      x.at(index), y.at(index), {cosθ.at(index), sinθ.at(index)}};
+  Translation2v<double> v_k{vx.at(index), vy.at(index)};
+  auto ω_k = ω.at(index);
+  Translation2v<double> a_k{ax.at(index), ay.at(index)};
+  auto α_k = α.at(index);
+
+  auto start_time = std::chrono::steady_clock::now();
+  std::visit(
+      [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
+      constraint);
+  constraint_timing.add(constraint.index(),
+                        std::chrono::steady_clock::now() - start_time);
+}
+
+size_t SwerveTrajectoryGenerator::activate_keep_outs(
+    double activation_distance) {
+  size_t activated = 0;
+  std::erase_if(inactive_keep_outs, [&](auto& keep_out) {
+    auto& [index, constraint] = keep_out;
+    const auto& keep_out_constraint =
+        std::get<KeepOutPolygonConstraint>(constraint);
+
+    Pose2d pose{x[index].value(),
+                y[index].value(),
+                {cosθ[index].value(), sinθ[index].value()}};
+    if (keep_out_constraint.distance(pose) >=
+        keep_out_constraint.min_distance() + activation_distance) {
+      return false;
+    }
+
+    apply_constraint(index, constraint);
+    ++activated;
+    return true;
+  });
+  return activated;
+}
+
 void SwerveTrajectoryGenerator::apply_initial_guess(
     const SwerveSolution& solution) {
   size_t sample_total = x.size();
@@ -344,12 +666,17 @@ void SwerveTrajectoryGenerator::apply_initial_guess(
     sinθ[sample_index].set_value(solution.thetasin[sample_index]);
   }
 
+  // Eliminated accelerations follow the module forces instead
+  const bool guess_accelerations = !path_builder.get_eliminate_accelerations();
+
   vx[0].set_value(0.0);
   vy[0].set_value(0.0);
   ω[0].set_value(0.0);
-  ax[0].set_value(0.0);
-  ay[0].set_value(0.0);
-  α[0].set_value(0.0);
+  if (guess_accelerations) {
+    ax[0].set_value(0.0);
+    ay[0].set_value(0.0);
+    α[0].set_value(0.0);
+  }
 
   for (size_t sample_index = 1; sample_index < sample_total; ++sample_index) {
     vx[sample_index].set_value(
@@ -369,41 +696,102 @@ void SwerveTrajectoryGenerator::apply_initial_guess(
                                   .radians() /
                               solution.dt[sample_index]);
 
-    ax[sample_index].set_value(
-        (vx[sample_index].value() - vx[sample_index - 1].value()) /
-        solution.dt[sample_index]);
-    ay[sample_index].set_value(
-        (vy[sample_index].value() - vy[sample_index - 1].value()) /
-        solution.dt[sample_index]);
-    α[sample_index].set_value(
-        (ω[sample_index].value() - ω[sample_index - 1].value()) /
-        solution.dt[sample_index]);
+    if (guess_accelerations) {
+      ax[sample_index].set_value(
+          (vx[sample_index].value() - vx[sample_index - 1].value()) /
+          solution.dt[sample_index]);
+      ay[sample_index].set_value(
+          (vy[sample_index].value() - vy[sample_index - 1].value()) /
+          solution.dt[sample_index]);
+      α[sample_index].set_value(
+          (ω[sample_index].value() - ω[sample_index - 1].value()) /
+          solution.dt[sample_index]);
+    }
   }
 }
 
-SwerveSolution SwerveTrajectoryGenerator::construct_swerve_solution() {
-  auto get_value = [](auto& var) { return var.value(); };
+void SwerveTrajectoryGenerator::apply_warm_start(
+    const SwerveSolution& solution) {
+  size_t sample_total = x.size();
+  size_t module_cnt = path.drivetrain.modules.size();
+
+  auto has_sample_total = [&](const auto& row) {
+    return row.size() == sample_total;
+  };
+  auto has_shape = [&](const SampleMatrix<double>& matrix) {
+    return matrix.sample_count() == sample_total &&
+           matrix.column_count() == module_cnt;
+  };
+  if (!std::ranges::all_of(
+          std::array{&solution.dt, &solution.x, &solution.y,
+                     &solution.thetacos, &solution.thetasin, &solution.vx,
+                     &solution.vy, &solution.omega, &solution.ax,
+                     &solution.ay, &solution.alpha},
+          [&](const auto* row) { return has_sample_total(*row); }) ||
+      !has_shape(solution.module_fx) || !has_shape(solution.module_fy)) {
+    return;
+  }
+
+  for (size_t sample_index = 0; sample_index < sample_total; ++sample_index) {
+    dts[sample_index].set_value(solution.dt[sample_index]);
+    x[sample_index].set_value(solution.x[sample_index]);
+    y[sample_index].set_value(solution.y[sample_index]);
+    cosθ[sample_index].set_value(solution.thetacos[sample_index]);
+    sinθ[sample_index].set_value(solution.thetasin[sample_index]);
+    vx[sample_index].set_value(solution.vx[sample_index]);
+    vy[sample_index].set_value(solution.vy[sample_index]);
+    ω[sample_index].set_value(solution.omega[sample_index]);
+    if (!path_builder.get_eliminate_accelerations()) {
+      ax[sample_index].set_value(solution.ax[sample_index]);
+      ay[sample_index].set_value(solution.ay[sample_index]);
+      α[sample_index].set_value(solution.alpha[sample_index]);
+    }
+
+    for (size_t module_index = 0; module_index < module_cnt; ++module_index) {
+      Fx[sample_index][module_index].set_value(
+          solution.module_fx[sample_index][module_index]);
+      Fy[sample_index][module_index].set_value(
+          solution.module_fy[sample_index][module_index]);
+    }
+  }
+}
 
-  auto vector_value = [&](std::vector<slp::Variable<double>>& row) {
-    return row | std::views::transform(get_value) |
-           std::ranges::to<std::vector>();
+const SwerveSolution& SwerveTrajectoryGenerator::update_snapshot() {
+  // Resizing only allocates on the first update
+  auto copy_values = [](std::span<slp::Variable<double>> variables,
+                        std::span<double> values) {
+    for (size_t i = 0; i < variables.size(); ++i) {
+      values[i] = variables[i].value();
+    }
   };
+  auto copy_row = [&](std::vector<slp::Variable<double>>& variables,
+                      std::vector<double>& values) {
+    values.resize(variables.size());
+    copy_values(variables, values);
+  };
+
+  copy_row(dts, snapshot.dt);
+  copy_row(x, snapshot.x);
+  copy_row(y, snapshot.y);
+  copy_row(cosθ, snapshot.thetacos);
+  copy_row(sinθ, snapshot.thetasin);
+  copy_row(vx, snapshot.vx);
+  copy_row(vy, snapshot.vy);
+  copy_row(ω, snapshot.omega);
+  copy_row(ax, snapshot.ax);
+  copy_row(ay, snapshot.ay);
+  copy_row(α, snapshot.alpha);
+
+  snapshot.module_fx.resize(Fx.sample_count(), Fx.column_count());
+  snapshot.module_fy.resize(Fy.sample_count(), Fy.column_count());
+  copy_values(Fx.values(), snapshot.module_fx.values());
+  copy_values(Fy.values(), snapshot.module_fy.values());
+
+  return snapshot;
+}
 
-  auto matrix_value =
-      [&](std::vector<std::vector<slp::Variable<double>>>& mat) {
-        return mat | std::views::transform([&](auto& v) {
-                 return v | std::views::transform(get_value) |
-                        std::ranges::to<std::vector>();
-               }) |
-               std::ranges::to<std::vector>();
-      };
-
-  return SwerveSolution{
-      vector_value(dts),  vector_value(x),    vector_value(y),
-      vector_value(cosθ), vector_value(sinθ), vector_value(vx),
-      vector_value(vy),   vector_value(ω),    vector_value(ax),
-      vector_value(ay),   vector_value(α),    matrix_value(Fx),
-      matrix_value(Fy)};
+SwerveSolution SwerveTrajectoryGenerator::construct_swerve_solution() {
+  return update_snapshot();
 }
 
 }  // namespace trajopt
@@ -2,11 +2,44 @@
 
 #include "trajopt/util/cancellation.hpp"
 
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
 namespace trajopt {
 
-std::atomic<int>& get_cancellation_flag() {
-  static std::atomic<int> flag{0};
-  return flag;
+namespace {
+
+// Incremented by cancel_all(). A token is cancelled if the epoch changed since
+// it was constructed or last reset.
+std::atomic<uint64_t>& get_cancellation_epoch() {
+  static std::atomic<uint64_t> epoch{0};
+  return epoch;
+}
+
+}  // namespace
+
+CancellationToken::CancellationToken() : m_state{std::make_shared<State>()} {
+  m_state->epoch = get_cancellation_epoch().load();
+}
+
+void CancellationToken::cancel() {
+  m_state->cancelled = true;
+}
+
+void CancellationToken::reset() {
+  m_state->epoch = get_cancellation_epoch().load();
+  m_state->cancelled = false;
+}
+
+bool CancellationToken::is_cancelled() const {
+  return m_state->cancelled ||
+         m_state->epoch.load() != get_cancellation_epoch().load();
+}
+
+void cancel_all() {
+  ++get_cancellation_epoch();
 }
 
 }  // namespace trajopt
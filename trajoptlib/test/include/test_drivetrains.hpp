@@ -0,0 +1,30 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+
+/// Returns the swerve drivetrain the tests solve with: a 45 kg robot with its
+/// modules at the corners of a 1.2 m square.
+inline trajopt::SwerveDrivetrain test_swerve_drivetrain() {
+  return {.mass = 45,
+          .moi = 6,
+          .wheel_radius = 0.04,
+          .wheel_max_angular_velocity = 70,
+          .wheel_max_torque = 2,
+          .wheel_cof = 1.5,
+          .modules = {{+0.6, +0.6}, {+0.6, -0.6}, {-0.6, +0.6}, {-0.6, -0.6}}};
+}
+
+/// Returns the differential drivetrain the tests solve with: a 45 kg robot
+/// with a 0.6 m trackwidth.
+inline trajopt::DifferentialDrivetrain test_differential_drivetrain() {
+  return {.mass = 45,
+          .moi = 6,
+          .wheel_radius = 0.08,
+          .wheel_max_angular_velocity = 70,
+          .wheel_max_torque = 5,
+          .wheel_cof = 1.5,
+          .trackwidth = 0.6};
+}
@@ -0,0 +1,169 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <sleipnir/optimization/solver/exit_status.hpp>
+#include <trajopt/batch_trajectory_generator.hpp>
+#include <trajopt/util/cancellation.hpp>
+
+#include "test_drivetrains.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+trajopt::SwervePathBuilder swerve_path(double x, size_t interval_count) {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, x, 1.0, 0.5);
+  path.set_control_interval_counts({interval_count});
+  return path;
+}
+
+trajopt::DifferentialPathBuilder differential_path(double x,
+                                                   size_t interval_count) {
+  trajopt::DifferentialPathBuilder path;
+  path.set_drivetrain(test_differential_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, x, 0.0, 0.0);
+  path.set_control_interval_counts({interval_count});
+  return path;
+}
+
+void check_same_samples(const std::vector<double>& actual,
+                        const std::vector<double>& expected) {
+  REQUIRE(actual.size() == expected.size());
+  for (size_t sample = 0; sample < expected.size(); ++sample) {
+    CHECK_THAT(actual[sample], WithinAbs(expected[sample], 1e-9));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("BatchTrajectoryGenerator - Results match single solves",
+          "[BatchTrajectoryGenerator]") {
+  // Mixed drivetrains and sizes, added out of cost order so the workers run
+  // them in a different order than their indices
+  std::vector<trajopt::SwervePathBuilder> swerve_paths{
+      swerve_path(1.0, 5), swerve_path(3.0, 20), swerve_path(2.0, 10)};
+  std::vector<trajopt::DifferentialPathBuilder> differential_paths{
+      differential_path(1.5, 8), differential_path(4.0, 25)};
+
+  trajopt::BatchTrajectoryGenerator batch{2};
+  std::vector<size_t> swerve_indices;
+  std::vector<size_t> differential_indices;
+  for (size_t i = 0; i < swerve_paths.size(); ++i) {
+    swerve_indices.push_back(batch.add(swerve_paths[i]));
+    differential_indices.push_back(batch.add(differential_paths[i % 2]));
+  }
+  REQUIRE(batch.size() == 6);
+
+  auto results = batch.generate();
+  REQUIRE(results.size() == batch.size());
+
+  for (size_t i = 0; i < swerve_indices.size(); ++i) {
+    CAPTURE(i);
+    auto& result = results[swerve_indices[i]];
+    REQUIRE(std::holds_alternative<
+            trajopt::BatchTrajectoryGenerator::SwerveResult>(result));
+    auto& solution =
+        std::get<trajopt::BatchTrajectoryGenerator::SwerveResult>(result);
+    REQUIRE(solution.has_value());
+
+    trajopt::SwerveTrajectoryGenerator generator{swerve_paths[i]};
+    auto expected = generator.generate();
+    REQUIRE(expected.has_value());
+
+    check_same_samples(solution->x, expected->x);
+    check_same_samples(solution->y, expected->y);
+    check_same_samples(solution->thetacos, expected->thetacos);
+    check_same_samples(solution->dt, expected->dt);
+  }
+
+  for (size_t i = 0; i < differential_indices.size(); ++i) {
+    CAPTURE(i);
+    auto& result = results[differential_indices[i]];
+    REQUIRE(std::holds_alternative<
+            trajopt::BatchTrajectoryGenerator::DifferentialResult>(result));
+    auto& solution =
+        std::get<trajopt::BatchTrajectoryGenerator::DifferentialResult>(
+            result);
+    REQUIRE(solution.has_value());
+
+    trajopt::DifferentialTrajectoryGenerator generator{
+        differential_paths[i % 2]};
+    auto expected = generator.generate();
+    REQUIRE(expected.has_value());
+
+    check_same_samples(solution->x, expected->x);
+    check_same_samples(solution->y, expected->y);
+    check_same_samples(solution->heading, expected->heading);
+    check_same_samples(solution->dt, expected->dt);
+  }
+}
+
+TEST_CASE("BatchTrajectoryGenerator - Per-job cancellation",
+          "[BatchTrajectoryGenerator]") {
+  using Result = trajopt::BatchTrajectoryGenerator::SwerveResult;
+
+  // One job cancels itself from its own callback, during its solve
+  trajopt::CancellationToken self_cancelling_token;
+  auto self_cancelling_path = swerve_path(2.0, 10);
+  self_cancelling_path.add_callback(
+      [&](const trajopt::SwerveSolution&, int64_t) {
+        self_cancelling_token.cancel();
+      },
+      std::numeric_limits<double>::infinity());
+
+  trajopt::BatchTrajectoryGenerator batch{2};
+  size_t before_index = batch.add(swerve_path(1.0, 5));
+  size_t during_index = batch.add(self_cancelling_path);
+  std::vector<size_t> other_indices{batch.add(swerve_path(3.0, 20)),
+                                    batch.add(swerve_path(1.5, 8))};
+
+  // Another is cancelled before generation starts
+  batch.cancellation_token(before_index).cancel();
+  self_cancelling_token = batch.cancellation_token(during_index);
+
+  auto results = batch.generate();
+  REQUIRE(results.size() == batch.size());
+
+  for (size_t index : {before_index, during_index}) {
+    CAPTURE(index);
+    const auto& result = std::get<Result>(results[index]);
+    REQUIRE_FALSE(result.has_value());
+    CHECK(result.error() == slp::ExitStatus::CALLBACK_REQUESTED_STOP);
+  }
+
+  // The other jobs are unaffected
+  for (size_t index : other_indices) {
+    CAPTURE(index);
+    CHECK(std::get<Result>(results[index]).has_value());
+  }
+}
+
+TEST_CASE("BatchTrajectoryGenerator - Exceptions reach the caller",
+          "[BatchTrajectoryGenerator]") {
+  auto throwing_path = swerve_path(2.0, 10);
+  throwing_path.add_callback(
+      [](const trajopt::SwerveSolution&, int64_t) {
+        throw std::runtime_error{"callback failed"};
+      },
+      std::numeric_limits<double>::infinity());
+
+  trajopt::BatchTrajectoryGenerator batch{2};
+  batch.add(swerve_path(1.0, 5));
+  batch.add(throwing_path);
+  batch.add(differential_path(1.5, 8));
+
+  CHECK_THROWS_AS(batch.generate(), std::runtime_error);
+}
@@ -0,0 +1,170 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <utility>
+#include <variant>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+#include <trajopt/constraint/constraint.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/simplify_constraints.hpp>
+
+#include "test_drivetrains.hpp"
+
+namespace {
+
+/// A user constraint the library doesn't know about.
+struct MaxTurnRateConstraint {
+  double max_turn_rate;
+
+  void apply(slp::Problem<double>& problem,
+             [[maybe_unused]] const trajopt::Pose2v<double>& pose,
+             [[maybe_unused]] const trajopt::Translation2v<double>& v,
+             const slp::Variable<double>& ω,
+             [[maybe_unused]] const trajopt::Translation2v<double>& a,
+             [[maybe_unused]] const slp::Variable<double>& α) {
+    problem.subject_to(ω * ω <= max_turn_rate * max_turn_rate);
+  }
+
+  bool operator==(const MaxTurnRateConstraint& other) const = default;
+};
+
+/// A user constraint too large for AnyConstraint's inline buffer, without
+/// operator==.
+struct LargeConstraint {
+  std::array<double, 16> values{};
+
+  void apply([[maybe_unused]] slp::Problem<double>& problem,
+             [[maybe_unused]] const trajopt::Pose2v<double>& pose,
+             [[maybe_unused]] const trajopt::Translation2v<double>& v,
+             [[maybe_unused]] const slp::Variable<double>& ω,
+             [[maybe_unused]] const trajopt::Translation2v<double>& a,
+             [[maybe_unused]] const slp::Variable<double>& α) {}
+};
+
+/// A path that turns half a revolution while driving two meters.
+trajopt::SwervePathBuilder turning_path(size_t interval_count) {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 2.0, 0.0, std::numbers::pi);
+  path.set_control_interval_counts({interval_count});
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("AnyConstraint - User constraints in a path", "[AnyConstraint]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.set_control_interval_counts({5});
+
+  path.wpt_constraint(0, MaxTurnRateConstraint{1.0});
+  path.wpt_constraint(0, MaxTurnRateConstraint{1.0});
+  path.wpt_constraint(0, MaxTurnRateConstraint{2.0});
+  path.wpt_constraint(1, LargeConstraint{});
+  path.wpt_constraint(1, LargeConstraint{});
+
+  const auto& constraints = path.get_path().waypoints[0].waypoint_constraints;
+  REQUIRE(std::holds_alternative<AnyConstraint>(constraints.back()));
+  const auto& user_constraint = std::get<AnyConstraint>(constraints.back());
+  const auto* turn_rate = user_constraint.target<MaxTurnRateConstraint>();
+  REQUIRE(turn_rate != nullptr);
+  CHECK(turn_rate->max_turn_rate == 2.0);
+  CHECK(user_constraint.target<LargeConstraint>() == nullptr);
+
+  // Only the identical user constraint is removed; LargeConstraint has no
+  // operator==, so its copies are kept
+  auto simplified = path.get_path();
+  CHECK(simplify_constraints(simplified, {5}) == 1);
+  CHECK(simplified.waypoints[0].waypoint_constraints.size() == 3);
+  CHECK(simplified.waypoints[1].waypoint_constraints.size() == 3);
+}
+
+TEST_CASE("AnyConstraint - Copy and move", "[AnyConstraint]") {
+  trajopt::AnyConstraint inline_constraint = MaxTurnRateConstraint{1.0};
+  trajopt::AnyConstraint heap_constraint = LargeConstraint{{1.0}};
+
+  auto inline_copy = inline_constraint;
+  auto heap_copy = heap_constraint;
+  CHECK(inline_copy == inline_constraint);
+  CHECK(heap_copy.target<LargeConstraint>()->values[0] == 1.0);
+  CHECK(heap_copy.target<LargeConstraint>() !=
+        heap_constraint.target<LargeConstraint>());
+
+  auto moved = std::move(inline_copy);
+  CHECK(moved.target<MaxTurnRateConstraint>()->max_turn_rate == 1.0);
+  moved = std::move(heap_copy);
+  CHECK(moved.target<LargeConstraint>()->values[0] == 1.0);
+  moved = inline_constraint;
+  CHECK(moved == inline_constraint);
+}
+
+TEST_CASE("AnyConstraint - User constraint takes effect", "[AnyConstraint]") {
+  constexpr double max_turn_rate = 1.0;
+
+  auto unconstrained_path = turning_path(20);
+  trajopt::SwerveTrajectoryGenerator unconstrained_generator{
+      unconstrained_path};
+  auto unconstrained_solution = unconstrained_generator.generate();
+  REQUIRE(unconstrained_solution.has_value());
+  double unconstrained_turn_rate = 0.0;
+  for (double ω : unconstrained_solution->omega) {
+    unconstrained_turn_rate = std::max(unconstrained_turn_rate, std::abs(ω));
+  }
+  CHECK(unconstrained_turn_rate > max_turn_rate);
+
+  // Segment constraints skip the segment's last sample, so constrain the final
+  // waypoint too
+  auto path = turning_path(20);
+  path.sgmt_constraint(0, 1, MaxTurnRateConstraint{max_turn_rate});
+  path.wpt_constraint(1, MaxTurnRateConstraint{max_turn_rate});
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  auto solution = generator.generate();
+  REQUIRE(solution.has_value());
+
+  for (size_t sample = 0; sample < solution->omega.size(); ++sample) {
+    CAPTURE(sample);
+    CHECK(std::abs(solution->omega[sample]) <= max_turn_rate + 1e-6);
+  }
+}
+
+TEST_CASE("AnyConstraint - Generator benchmark",
+          "[.][benchmark][AnyConstraint]") {
+  using namespace trajopt;
+
+  // Only built-in constraints, so this is comparable with builds before
+  // AnyConstraint was added to the Constraint variant
+  auto built_in_path = turning_path(100);
+  built_in_path.sgmt_constraint(0, 1,
+                                AngularVelocityMaxMagnitudeConstraint{1.0});
+  built_in_path.sgmt_constraint(0, 1,
+                                LinearVelocityMaxMagnitudeConstraint{2.0});
+
+  auto user_path = turning_path(100);
+  user_path.sgmt_constraint(0, 1, MaxTurnRateConstraint{1.0});
+  user_path.sgmt_constraint(0, 1, LinearVelocityMaxMagnitudeConstraint{2.0});
+
+  BENCHMARK("Built-in constraints, construction") {
+    SwerveTrajectoryGenerator generator{built_in_path};
+  };
+
+  BENCHMARK("Built-in constraints, generate") {
+    SwerveTrajectoryGenerator generator{built_in_path};
+    return generator.generate();
+  };
+
+  BENCHMARK("User constraint, construction") {
+    SwerveTrajectoryGenerator generator{user_path};
+  };
+}
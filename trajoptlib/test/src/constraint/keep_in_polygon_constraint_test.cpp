@@ -0,0 +1,39 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/constraint/keep_in_polygon_constraint.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+
+TEST_CASE("KeepInPolygonConstraint - Redundant edges", "[KeepIn]") {
+  using trajopt::Translation2d;
+
+  // A square with a repeated vertex and a vertex in the middle of an edge
+  std::vector<Translation2d> square{{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0},
+                                    {2.0, 0.0}, {2.0, 2.0}, {0.0, 2.0}};
+  trajopt::KeepInPolygonConstraint constraint{square};
+
+  CHECK(constraint.edge_count() == 4);
+  CHECK(constraint.robot_points() == std::vector<Translation2d>{{0.0, 0.0}});
+
+  std::vector<Translation2d> clockwise{square.rbegin(), square.rend()};
+  CHECK(trajopt::KeepInPolygonConstraint{clockwise}.edge_count() == 4);
+}
+
+TEST_CASE("PathBuilder - Keep-in polygon with bumpers", "[KeepIn]") {
+  using trajopt::Translation2d;
+
+  trajopt::SwervePathBuilder path;
+  path.set_bumpers(0.5, 0.5, 0.5, 0.5);
+  path.set_bumpers(0.25, 0.25, 0.25, 0.25);
+
+  auto constraint = path.keep_in_polygon(
+      {{0.0, 0.0}, {4.0, 0.0}, {4.0, 4.0}, {0.0, 4.0}});
+
+  // The center and the inner bumper are inside the outer bumper
+  CHECK(constraint.robot_points() ==
+        std::vector<Translation2d>{
+            {-0.5, -0.5}, {0.5, -0.5}, {0.5, 0.5}, {-0.5, 0.5}});
+  CHECK(constraint.edge_count() == 4);
+}
@@ -0,0 +1,88 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/constraint/keep_out_polygon_constraint.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/geometry/pose2.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+
+#include "test_drivetrains.hpp"
+
+namespace {
+
+/// Keep-outs the straight-line initial guess from (0, 0) to (4, 0) runs
+/// through.
+std::vector<trajopt::KeepOutPolygonConstraint> keep_outs_on_line(
+    const std::vector<trajopt::Translation2d>& robot_polygon) {
+  return {
+      // A circle, which is a one-point field polygon
+      trajopt::KeepOutPolygonConstraint{robot_polygon, {{1.5, 0.1}}, 0.3},
+      // A square
+      trajopt::KeepOutPolygonConstraint{
+          robot_polygon,
+          {{2.5, -0.3}, {3.0, -0.3}, {3.0, 0.2}, {2.5, 0.2}},
+          0.1}};
+}
+
+}  // namespace
+
+TEST_CASE("KeepOutPolygonConstraint - Swerve samples clear the keep-outs",
+          "[KeepOut]") {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.set_bumpers(0.4, 0.4, 0.4, 0.4);
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 4.0, 0.0, 0.0);
+  path.set_control_interval_counts({40});
+
+  auto keep_outs = keep_outs_on_line(path.get_bumpers().front().points);
+  for (const auto& keep_out : keep_outs) {
+    path.sgmt_constraint(0, 1, keep_out);
+  }
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  auto solution = generator.generate();
+  REQUIRE(solution.has_value());
+
+  for (size_t sample = 0; sample < solution->x.size(); ++sample) {
+    trajopt::Pose2d pose{
+        solution->x[sample],
+        solution->y[sample],
+        {solution->thetacos[sample], solution->thetasin[sample]}};
+    for (const auto& keep_out : keep_outs) {
+      CAPTURE(sample, pose.x(), pose.y());
+      CHECK(keep_out.distance(pose) >= keep_out.min_distance() - 1e-6);
+    }
+  }
+}
+
+TEST_CASE("KeepOutPolygonConstraint - Differential samples clear the keep-outs",
+          "[KeepOut]") {
+  trajopt::DifferentialPathBuilder path;
+  path.set_drivetrain(test_differential_drivetrain());
+  path.set_bumpers(0.4, 0.4, 0.4, 0.4);
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 4.0, 0.0, 0.0);
+  path.set_control_interval_counts({40});
+
+  auto keep_outs = keep_outs_on_line(path.get_bumpers().front().points);
+  for (const auto& keep_out : keep_outs) {
+    path.sgmt_constraint(0, 1, keep_out);
+  }
+
+  trajopt::DifferentialTrajectoryGenerator generator{path};
+  auto solution = generator.generate();
+  REQUIRE(solution.has_value());
+
+  for (size_t sample = 0; sample < solution->x.size(); ++sample) {
+    trajopt::Pose2d pose{solution->x[sample], solution->y[sample],
+                         solution->heading[sample]};
+    for (const auto& keep_out : keep_outs) {
+      CAPTURE(sample, pose.x(), pose.y());
+      CHECK(keep_out.distance(pose) >= keep_out.min_distance() - 1e-6);
+    }
+  }
+}
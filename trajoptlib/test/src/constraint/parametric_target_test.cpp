@@ -0,0 +1,215 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <limits>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/constraint/constraint.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/simplify_constraints.hpp>
+
+#include "test_drivetrains.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+/// A three-waypoint path whose middle waypoint is at a pose.
+template <typename PathBuilder, typename Drivetrain>
+PathBuilder three_waypoint_path(const Drivetrain& drivetrain,
+                                const trajopt::Pose2d& middle) {
+  PathBuilder path;
+  path.set_drivetrain(drivetrain);
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, middle.x(), middle.y(), middle.rotation().radians());
+  path.pose_wpt(2, 4.0, 1.0, 0.0);
+  path.set_control_interval_counts({10, 10});
+  return path;
+}
+
+/// Adds a callback to a path that counts solver iterations.
+template <typename PathBuilder>
+void count_iterations(PathBuilder& path, size_t& iterations) {
+  path.add_callback([&](const auto&, int64_t) { ++iterations; },
+                    std::numeric_limits<double>::infinity());
+}
+
+}  // namespace
+
+TEST_CASE("PoseEqualityConstraint - Bound target", "[ParametricTarget]") {
+  using namespace trajopt;
+
+  Constraint constraint = PoseEqualityConstraint{1.0, 2.0, 0.0};
+  Constraint copy = constraint;
+
+  // Unbound copies are independent values
+  CHECK(set_target_pose(constraint, Pose2d{3.0, 4.0, 0.0}));
+  CHECK(std::get<PoseEqualityConstraint>(copy).pose() ==
+        Pose2d{1.0, 2.0, 0.0});
+
+  // Bound copies share the parameter, as a generator's problem would
+  bind_target_parameters(constraint);
+  copy = constraint;
+  CHECK(copy == constraint);
+  set_target_pose(constraint, Pose2d{5.0, 6.0, 0.0});
+  CHECK(std::get<PoseEqualityConstraint>(copy).pose().x() == 5.0);
+  CHECK(std::get<PoseEqualityConstraint>(copy).pose().y() == 6.0);
+
+  Constraint translation = TranslationEqualityConstraint{1.0, 2.0};
+  bind_target_parameters(translation);
+  CHECK(set_target_pose(translation, Pose2d{7.0, 8.0, 1.0}));
+  CHECK(std::get<TranslationEqualityConstraint>(translation).translation() ==
+        Translation2d{7.0, 8.0});
+
+  Constraint other = LinearVelocityMaxMagnitudeConstraint{1.0};
+  bind_target_parameters(other);
+  CHECK_FALSE(set_target_pose(other, Pose2d{}));
+}
+
+TEST_CASE("unbind_parameters() - Copies stop sharing", "[ParametricTarget]") {
+  using namespace trajopt;
+
+  PoseParameter pose{Pose2d{1.0, 2.0, 0.0}};
+  TranslationParameter translation{Translation2d{3.0, 4.0}};
+  std::vector<Constraint> constraints{
+      PoseEqualityConstraint{pose}, TranslationEqualityConstraint{translation},
+      PointAtConstraint{translation, 0.1}};
+  for (auto& constraint : constraints) {
+    unbind_parameters(constraint);
+  }
+
+  // The unbound copies keep the values they had
+  pose.set_value(Pose2d{5.0, 6.0, 1.0});
+  translation.set_value(Translation2d{7.0, 8.0});
+  CHECK(std::get<PoseEqualityConstraint>(constraints[0]).pose() ==
+        Pose2d{1.0, 2.0, 0.0});
+  CHECK(std::get<TranslationEqualityConstraint>(constraints[1])
+            .translation() == Translation2d{3.0, 4.0});
+  CHECK(std::get<PointAtConstraint>(constraints[2]).field_point() ==
+        Translation2d{3.0, 4.0});
+  CHECK_FALSE(std::get<PointAtConstraint>(constraints[2])
+                  .has_same_field_point(PointAtConstraint{translation, 0.1}));
+}
+
+TEST_CASE("PointAtConstraint - Parametric field point", "[ParametricTarget]") {
+  using namespace trajopt;
+
+  TranslationParameter goal{Translation2d{1.0, 1.0}};
+  TranslationParameter other_goal{Translation2d{1.0, 1.0}};
+
+  // Parameters with equal values can still move apart, so neither constraint
+  // implies the other
+  std::vector<Constraint> constraints{PointAtConstraint{goal, 0.1},
+                                      PointAtConstraint{other_goal, 0.2},
+                                      PointAtConstraint{goal, 0.2}};
+  CHECK(detail::remove_implied(constraints) == 1);
+  CHECK(constraints.size() == 2);
+
+  goal.set_value({3.0, 4.0});
+  CHECK(std::get<PointAtConstraint>(constraints[0]).field_point() ==
+        Translation2d{3.0, 4.0});
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Set waypoint pose",
+          "[ParametricTarget]") {
+  const trajopt::Pose2d middle{2.0, 0.5, 0.3};
+  const trajopt::Pose2d moved{2.0, 0.8, 0.5};
+
+  size_t iterations = 0;
+  auto path = three_waypoint_path<trajopt::SwervePathBuilder>(
+      test_swerve_drivetrain(), middle);
+  count_iterations(path, iterations);
+
+  trajopt::SwerveTrajectoryGenerator generator{path};
+  REQUIRE(generator.generate().has_value());
+
+  iterations = 0;
+  generator.set_waypoint_pose(1, moved);
+  auto warm_solution = generator.resolve();
+  REQUIRE(warm_solution.has_value());
+  size_t warm_iterations = iterations;
+
+  // The middle waypoint's sample lands on the new pose
+  CHECK_THAT(warm_solution->x[10], WithinAbs(moved.x(), 1e-6));
+  CHECK_THAT(warm_solution->y[10], WithinAbs(moved.y(), 1e-6));
+  CHECK_THAT(warm_solution->thetacos[10],
+             WithinAbs(moved.rotation().cos(), 1e-6));
+  CHECK_THAT(warm_solution->thetasin[10],
+             WithinAbs(moved.rotation().sin(), 1e-6));
+
+  // A cold solve of a path built with the moved waypoint reaches the same
+  // trajectory in more iterations
+  auto moved_path = three_waypoint_path<trajopt::SwervePathBuilder>(
+      test_swerve_drivetrain(), moved);
+  count_iterations(moved_path, iterations);
+
+  iterations = 0;
+  trajopt::SwerveTrajectoryGenerator cold_generator{moved_path};
+  auto cold_solution = cold_generator.generate();
+  REQUIRE(cold_solution.has_value());
+  CHECK(warm_iterations < iterations);
+
+  REQUIRE(warm_solution->x.size() == cold_solution->x.size());
+  for (size_t sample = 0; sample < cold_solution->x.size(); ++sample) {
+    CHECK_THAT(warm_solution->x[sample],
+               WithinAbs(cold_solution->x[sample], 1e-3));
+    CHECK_THAT(warm_solution->y[sample],
+               WithinAbs(cold_solution->y[sample], 1e-3));
+    CHECK_THAT(warm_solution->dt[sample],
+               WithinAbs(cold_solution->dt[sample], 1e-3));
+  }
+}
+
+TEST_CASE("DifferentialTrajectoryGenerator - Set waypoint pose",
+          "[ParametricTarget]") {
+  const trajopt::Pose2d middle{2.0, 0.5, 0.3};
+  const trajopt::Pose2d moved{2.0, 0.8, 0.5};
+
+  size_t iterations = 0;
+  auto path = three_waypoint_path<trajopt::DifferentialPathBuilder>(
+      test_differential_drivetrain(), middle);
+  count_iterations(path, iterations);
+
+  trajopt::DifferentialTrajectoryGenerator generator{path};
+  REQUIRE(generator.generate().has_value());
+
+  iterations = 0;
+  generator.set_waypoint_pose(1, moved);
+  auto warm_solution = generator.resolve();
+  REQUIRE(warm_solution.has_value());
+  size_t warm_iterations = iterations;
+
+  // The middle waypoint's sample lands on the new pose
+  CHECK_THAT(warm_solution->x[10], WithinAbs(moved.x(), 1e-6));
+  CHECK_THAT(warm_solution->y[10], WithinAbs(moved.y(), 1e-6));
+  CHECK_THAT(warm_solution->heading[10],
+             WithinAbs(moved.rotation().radians(), 1e-6));
+
+  // A cold solve of a path built with the moved waypoint reaches the same
+  // trajectory in more iterations
+  auto moved_path = three_waypoint_path<trajopt::DifferentialPathBuilder>(
+      test_differential_drivetrain(), moved);
+  count_iterations(moved_path, iterations);
+
+  iterations = 0;
+  trajopt::DifferentialTrajectoryGenerator cold_generator{moved_path};
+  auto cold_solution = cold_generator.generate();
+  REQUIRE(cold_solution.has_value());
+  CHECK(warm_iterations < iterations);
+
+  REQUIRE(warm_solution->x.size() == cold_solution->x.size());
+  for (size_t sample = 0; sample < cold_solution->x.size(); ++sample) {
+    CHECK_THAT(warm_solution->x[sample],
+               WithinAbs(cold_solution->x[sample], 1e-3));
+    CHECK_THAT(warm_solution->y[sample],
+               WithinAbs(cold_solution->y[sample], 1e-3));
+    CHECK_THAT(warm_solution->dt[sample],
+               WithinAbs(cold_solution->dt[sample], 1e-3));
+  }
+}
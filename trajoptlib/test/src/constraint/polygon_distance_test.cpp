@@ -0,0 +1,45 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/constraint/detail/polygon_distance.hpp>
+#include <trajopt/constraint/keep_out_polygon_constraint.hpp>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("polygon_distance() - Separated and overlapping", "[KeepOut]") {
+  using trajopt::Translation2d;
+  using trajopt::detail::polygon_distance;
+
+  std::vector<Translation2d> square{
+      {0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}};
+
+  // Vertex to edge
+  CHECK_THAT(polygon_distance(square, {{2.0, 0.5}}), WithinAbs(1.0, 1e-9));
+  // Vertex to vertex
+  CHECK_THAT(polygon_distance(square, {{2.0, 2.0}}),
+             WithinAbs(std::sqrt(2.0), 1e-9));
+  // Point inside
+  CHECK(polygon_distance(square, {{0.5, 0.5}}) == 0.0);
+  // Overlapping squares
+  CHECK(polygon_distance(square, {{0.5, 0.5}, {1.5, 0.5}, {1.5, 1.5}}) == 0.0);
+  // Disjoint collinear segments
+  CHECK_THAT(
+      polygon_distance({{0.0, 0.0}, {1.0, 0.0}}, {{2.0, 0.0}, {3.0, 0.0}}),
+      WithinAbs(1.0, 1e-9));
+}
+
+TEST_CASE("KeepOutPolygonConstraint - Distance at pose", "[KeepOut]") {
+  trajopt::KeepOutPolygonConstraint constraint{
+      {{0.5, 0.5}, {-0.5, 0.5}, {-0.5, -0.5}, {0.5, -0.5}}, {{3.0, 0.0}}, 1.0};
+
+  CHECK_THAT(constraint.distance({0.0, 0.0, 0.0}), WithinAbs(2.5, 1e-9));
+  // Rotating the bumpers puts a corner closer to the obstacle
+  CHECK_THAT(constraint.distance({0.0, 0.0, std::numbers::pi / 4}),
+             WithinAbs(3.0 - std::sqrt(0.5), 1e-9));
+  CHECK(constraint.distance({3.0, 0.0, 0.0}) == 0.0);
+}
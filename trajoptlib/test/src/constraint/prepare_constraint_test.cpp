@@ -0,0 +1,211 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+#include <trajopt/constraint/constraint.hpp>
+#include <trajopt/constraint/detail/line_point_squared_distance.hpp>
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+/// LinePointConstraint's formulation before prepare(), which rotates both line
+/// endpoints and takes the rotated line's squared norm.
+struct BaselineLinePointConstraint {
+  trajopt::Translation2d robot_line_start;
+  trajopt::Translation2d robot_line_end;
+  trajopt::Translation2d field_point;
+  double min_distance;
+
+  void apply(slp::Problem<double>& problem,
+             const trajopt::Pose2v<double>& pose,
+             [[maybe_unused]] const trajopt::Translation2v<double>& v,
+             [[maybe_unused]] const slp::Variable<double>& ω,
+             [[maybe_unused]] const trajopt::Translation2v<double>& a,
+             [[maybe_unused]] const slp::Variable<double>& α) {
+    auto line_start =
+        pose.translation() + robot_line_start.rotate_by(pose.rotation());
+    auto line_end =
+        pose.translation() + robot_line_end.rotate_by(pose.rotation());
+    auto squared_distance = trajopt::detail::line_point_squared_distance(
+        line_start, line_end, field_point);
+    problem.subject_to(squared_distance >= min_distance * min_distance);
+  }
+};
+
+/// PointLineRegionConstraint's formulation before prepare(), which takes the
+/// cross product of the field line and the field line start to robot point.
+struct BaselinePointLineRegionConstraint {
+  trajopt::Translation2d robot_point;
+  trajopt::Translation2d field_line_start;
+  trajopt::Translation2d field_line_end;
+  trajopt::Side side;
+
+  void apply(slp::Problem<double>& problem,
+             const trajopt::Pose2v<double>& pose,
+             [[maybe_unused]] const trajopt::Translation2v<double>& v,
+             [[maybe_unused]] const slp::Variable<double>& ω,
+             [[maybe_unused]] const trajopt::Translation2v<double>& a,
+             [[maybe_unused]] const slp::Variable<double>& α) {
+    auto point = pose.translation() + robot_point.rotate_by(pose.rotation());
+    auto line = field_line_end - field_line_start;
+    auto cross = line.cross(point - field_line_start);
+
+    switch (side) {
+      case trajopt::Side::ABOVE:
+        problem.subject_to(cross > 0);
+        break;
+      case trajopt::Side::BELOW:
+        problem.subject_to(cross < 0);
+        break;
+      case trajopt::Side::ON:
+        problem.subject_to(cross == 0);
+        break;
+    }
+  }
+};
+
+/// Returns the pose closest to the goal's translation that satisfies the
+/// constraint, with the heading fixed at the goal's.
+template <typename Constraint>
+trajopt::Pose2d nearest_feasible_pose(Constraint constraint,
+                                      const trajopt::Pose2d& goal) {
+  slp::Problem<double> problem;
+  auto x = problem.decision_variable();
+  auto y = problem.decision_variable();
+  x.set_value(goal.x());
+  y.set_value(goal.y());
+
+  trajopt::Pose2v<double> pose{x, y,
+                               trajopt::Rotation2v<double>{goal.rotation()}};
+  trajopt::Translation2v<double> zero{slp::Variable<double>{0.0},
+                                      slp::Variable<double>{0.0}};
+  slp::Variable<double> zero_scalar{0.0};
+
+  problem.minimize((x - goal.x()) * (x - goal.x()) +
+                   (y - goal.y()) * (y - goal.y()));
+  constraint.apply(problem, pose, zero, zero_scalar, zero, zero_scalar);
+  REQUIRE(problem.solve() == slp::ExitStatus::SUCCESS);
+
+  return {x.value(), y.value(), goal.rotation()};
+}
+
+template <typename Constraint>
+double residual(const Constraint& constraint, const trajopt::Pose2d& pose) {
+  return constraint.residual(pose, {}, 0.0, {}, 0.0);
+}
+
+}  // namespace
+
+
+TEST_CASE("prepare_constraint() - Opt-in and equality", "[Constraint]") {
+  using namespace trajopt;
+
+  static_assert(PreparableConstraint<LaneConstraint>);
+  static_assert(PreparableConstraint<LinePointConstraint>);
+  static_assert(PreparableConstraint<PointLineRegionConstraint>);
+  static_assert(!PreparableConstraint<PoseEqualityConstraint>);
+
+  Constraint lane = LaneConstraint{{0.0, 0.0}, {1.0, 0.0}, 0.5};
+  Constraint prepared = lane;
+  prepare_constraint(prepared);
+  prepare_constraint(prepared);
+
+  // Derived geometry doesn't affect equality, so simplify_constraints() sees
+  // prepared and unprepared copies as duplicates
+  CHECK(prepared == lane);
+
+  Constraint pose = PoseEqualityConstraint{0.0, 0.0, 0.0};
+  prepare_constraint(pose);
+  CHECK(pose == Constraint{PoseEqualityConstraint{0.0, 0.0, 0.0}});
+}
+
+TEST_CASE("prepare_constraint() - LinePointConstraint matches baseline",
+          "[Constraint]") {
+  using namespace trajopt;
+
+  Translation2d line_start{-0.2, 0.1};
+  Translation2d line_end{0.3, 0.1};
+  Translation2d field_point{1.0, 0.0};
+  constexpr double min_distance = 0.4;
+
+  LinePointConstraint prepared{line_start, line_end, field_point, min_distance};
+  BaselineLinePointConstraint baseline{line_start, line_end, field_point,
+                                       min_distance};
+
+  // Goals inside the keep-out at several headings, so the constraint is active
+  for (const Pose2d& goal : {Pose2d{1.0, 0.2, 0.0}, Pose2d{0.8, -0.15, 0.7},
+                             Pose2d{1.1, 0.05, 2.5}}) {
+    CAPTURE(goal.x(), goal.y(), goal.rotation().radians());
+
+    auto prepared_pose = nearest_feasible_pose(prepared, goal);
+    auto baseline_pose = nearest_feasible_pose(baseline, goal);
+    CHECK_THAT(prepared_pose.x(), WithinAbs(baseline_pose.x(), 1e-6));
+    CHECK_THAT(prepared_pose.y(), WithinAbs(baseline_pose.y(), 1e-6));
+    CHECK_THAT(residual(prepared, prepared_pose), WithinAbs(0.0, 1e-6));
+  }
+}
+
+TEST_CASE("prepare_constraint() - Zero-length LinePointConstraint",
+          "[Constraint]") {
+  using namespace trajopt;
+
+  // The baseline divides by the line's zero squared length, so compare against
+  // the circle around the field point instead
+  Translation2d robot_point{0.2, 0.1};
+  Translation2d field_point{1.0, 0.0};
+  constexpr double min_distance = 0.4;
+  LinePointConstraint constraint{robot_point, robot_point, field_point,
+                                 min_distance};
+
+  for (const Pose2d& goal : {Pose2d{0.9, 0.1, 0.0}, Pose2d{0.7, -0.3, 1.2}}) {
+    CAPTURE(goal.x(), goal.y(), goal.rotation().radians());
+
+    auto pose = nearest_feasible_pose(constraint, goal);
+
+    // The nearest feasible point projects the goal's robot point radially onto
+    // the circle
+    auto goal_point =
+        goal.translation() + robot_point.rotate_by(goal.rotation());
+    auto offset = goal_point - field_point;
+    auto expected_point = field_point + offset * (min_distance / offset.norm());
+    auto point = pose.translation() + robot_point.rotate_by(pose.rotation());
+    CHECK_THAT(point.x(), WithinAbs(expected_point.x(), 1e-6));
+    CHECK_THAT(point.y(), WithinAbs(expected_point.y(), 1e-6));
+  }
+}
+
+TEST_CASE("prepare_constraint() - PointLineRegionConstraint matches baseline",
+          "[Constraint]") {
+  using namespace trajopt;
+
+  Translation2d field_line_start{0.0, 0.0};
+  Translation2d field_line_end{2.0, 1.0};
+
+  // Goals on the wrong side of the line, so the constraint is active
+  for (auto [side, goal] : {std::pair{Side::ABOVE, Pose2d{1.0, -0.5, 0.4}},
+                            std::pair{Side::BELOW, Pose2d{0.5, 1.0, -0.3}},
+                            std::pair{Side::ON, Pose2d{1.5, -0.2, 1.0}}}) {
+    // The origin takes the unrotated branch
+    for (const Translation2d& robot_point :
+         {Translation2d{}, Translation2d{0.3, -0.2}}) {
+      CAPTURE(static_cast<int>(side), robot_point.x(), robot_point.y());
+
+      PointLineRegionConstraint prepared{robot_point, field_line_start,
+                                         field_line_end, side};
+      BaselinePointLineRegionConstraint baseline{robot_point, field_line_start,
+                                                 field_line_end, side};
+
+      auto prepared_pose = nearest_feasible_pose(prepared, goal);
+      auto baseline_pose = nearest_feasible_pose(baseline, goal);
+      CHECK_THAT(prepared_pose.x(), WithinAbs(baseline_pose.x(), 1e-6));
+      CHECK_THAT(prepared_pose.y(), WithinAbs(baseline_pose.y(), 1e-6));
+      CHECK_THAT(residual(prepared, prepared_pose), WithinAbs(0.0, 1e-6));
+    }
+  }
+}
@@ -0,0 +1,37 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <array>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/spline/cubic_hermite_pose_spline_holonomic.hpp>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("CubicHermitePoseSplineHolonomic - Batch poses match get_point()",
+          "[CubicHermitePoseSplineHolonomic]") {
+  const trajopt::CubicHermitePoseSplineHolonomic spline{
+      {0.0, 2.0}, {3.0, 1.0}, {1.0, -1.0}, {2.0, 4.0}, {0.5}, {-2.0}};
+
+  constexpr std::array t{0.0, 0.1, 0.25, 0.5, 0.8, 1.0};
+  std::array<double, t.size()> x;
+  std::array<double, t.size()> y;
+  std::array<double, t.size()> heading_cos;
+  std::array<double, t.size()> heading_sin;
+
+  for (bool is_differential : {false, true}) {
+    INFO("is_differential = " << is_differential);
+
+    spline.get_poses(t, is_differential, x, y, heading_cos, heading_sin);
+
+    for (size_t i = 0; i < t.size(); ++i) {
+      INFO("t = " << t[i]);
+
+      auto pose = spline.get_point(t[i], is_differential).value().first;
+      CHECK_THAT(x[i], WithinAbs(pose.x(), 1e-12));
+      CHECK_THAT(y[i], WithinAbs(pose.y(), 1e-12));
+      CHECK_THAT(heading_cos[i], WithinAbs(pose.rotation().cos(), 1e-12));
+      CHECK_THAT(heading_sin[i], WithinAbs(pose.rotation().sin(), 1e-12));
+    }
+  }
+}
@@ -1,11 +1,16 @@
 // Copyright (c) TrajoptLib contributors
 
+#include <chrono>
+#include <limits>
+#include <numeric>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <trajopt/swerve_trajectory_generator.hpp>
 
+#include "test_drivetrains.hpp"
+
 using Catch::Matchers::WithinAbs;
 
 TEST_CASE("SwervePathBuilder - Linear initial guess", "[SwervePathBuilder]") {
@@ -51,3 +56,108 @@ TEST_CASE("SwervePathBuilder - Spline initial guess", "[SwervePathBuilder]") {
     CHECK_THAT(result[i], WithinAbs(expected[i], 1e-15));
   }
 }
+
+TEST_CASE("SwervePathBuilder - Callback rate", "[SwervePathBuilder]") {
+  using namespace std::chrono_literals;
+
+  trajopt::SwervePathBuilder path;
+  path.add_callback([](const trajopt::SwerveSolution&, int64_t) {});
+  path.add_callback([](const trajopt::SwerveSolution&, int64_t) {}, 10.0);
+  path.add_callback([](const trajopt::SwerveSolution&, int64_t) {}, 0.0);
+  path.add_callback([](const trajopt::SwerveSolution&, int64_t) {},
+                    std::numeric_limits<double>::infinity());
+
+  const auto& callbacks = path.get_path().callbacks;
+  REQUIRE(callbacks.size() == 4);
+
+  auto last_call_time = std::chrono::steady_clock::now();
+  auto now = last_call_time + 50ms;
+
+  CHECK(callbacks[0].is_due(now, last_call_time));
+  CHECK_FALSE(callbacks[1].is_due(now, last_call_time));
+  CHECK(callbacks[1].is_due(now + 50ms, last_call_time));
+  CHECK_FALSE(callbacks[2].is_due(now, last_call_time));
+  CHECK(callbacks[3].is_due(last_call_time, last_call_time));
+
+  // A callback that was never called is due immediately
+  CHECK(callbacks[1].is_due(now, {}));
+}
+
+TEST_CASE("SwervePathBuilder - Eliminated accelerations",
+          "[SwervePathBuilder]") {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 2.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 2.0, 1.0);
+  path.set_control_interval_counts({5, 5});
+
+  auto reduced_path = path;
+  reduced_path.set_eliminate_accelerations(true);
+  CHECK(reduced_path.sub_path(1, 2).get_eliminate_accelerations());
+
+  trajopt::SwerveTrajectoryGenerator full_generator{path};
+  auto full_solution = full_generator.generate();
+  REQUIRE(full_solution.has_value());
+
+  trajopt::SwerveTrajectoryGenerator reduced_generator{reduced_path};
+  auto reduced_solution = reduced_generator.generate();
+  REQUIRE(reduced_solution.has_value());
+
+  // Both formulations describe the same problem, so they have the same optimum
+  auto total_time = [](const trajopt::SwerveSolution& solution) {
+    return std::accumulate(solution.dt.begin(), solution.dt.end(), 0.0);
+  };
+  CHECK_THAT(total_time(*reduced_solution),
+             WithinAbs(total_time(*full_solution), 1e-3));
+
+  // The accelerations follow the warm started forces, so a warm start from
+  // the optimum comes back unchanged
+  trajopt::SwerveTrajectoryGenerator warm_generator{reduced_path};
+  auto warm_solution = warm_generator.generate(*reduced_solution);
+  REQUIRE(warm_solution.has_value());
+  for (size_t sample = 0; sample < reduced_solution->x.size(); ++sample) {
+    CHECK_THAT(warm_solution->x[sample],
+               WithinAbs(reduced_solution->x[sample], 1e-6));
+    CHECK_THAT(warm_solution->ax[sample],
+               WithinAbs(reduced_solution->ax[sample], 1e-6));
+    CHECK_THAT(warm_solution->alpha[sample],
+               WithinAbs(reduced_solution->alpha[sample], 1e-6));
+  }
+}
+
+TEST_CASE("SwervePathBuilder - Shared segment dt", "[SwervePathBuilder]") {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 2.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 2.0, 1.0);
+  path.set_control_interval_counts({5, 3});
+
+  auto shared_path = path;
+  shared_path.set_share_segment_dt(true);
+  CHECK(shared_path.sub_path(1, 2).get_share_segment_dt());
+
+  trajopt::SwerveTrajectoryGenerator per_sample_generator{path};
+  auto per_sample_solution = per_sample_generator.generate();
+  REQUIRE(per_sample_solution.has_value());
+
+  trajopt::SwerveTrajectoryGenerator shared_generator{shared_path};
+  auto shared_solution = shared_generator.generate();
+  REQUIRE(shared_solution.has_value());
+
+  // Both formulations describe the same problem, so they have the same
+  // optimum, and the solution still has one dt per sample within the bounds
+  REQUIRE(shared_solution->dt.size() == per_sample_solution->dt.size());
+  auto total_time = [](const trajopt::SwerveSolution& solution) {
+    return std::accumulate(solution.dt.begin(), solution.dt.end(), 0.0);
+  };
+  CHECK_THAT(total_time(*shared_solution),
+             WithinAbs(total_time(*per_sample_solution), 1e-3));
+  for (size_t sample = 0; sample < shared_solution->dt.size(); ++sample) {
+    CHECK_THAT(shared_solution->dt[sample],
+               WithinAbs(per_sample_solution->dt[sample], 1e-3));
+    CHECK(shared_solution->dt[sample] >= 0.0);
+    CHECK(shared_solution->dt[sample] <= 3.0);
+  }
+}
@@ -0,0 +1,285 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <numbers>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/geometry/translation2.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/transcription_method.hpp>
+
+#include "test_drivetrains.hpp"
+
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+constexpr std::pair<trajopt::TranscriptionMethod, std::string_view> methods[]{
+    {trajopt::TranscriptionMethod::DEFAULT, "Default"},
+    {trajopt::TranscriptionMethod::EXPLICIT_EULER, "Explicit Euler"},
+    {trajopt::TranscriptionMethod::TRAPEZOIDAL, "Trapezoidal"},
+    {trajopt::TranscriptionMethod::HERMITE_SIMPSON, "Hermite-Simpson"}};
+
+/// Returns a swerve path that drives two meters while turning around.
+trajopt::SwervePathBuilder swerve_path(trajopt::TranscriptionMethod method,
+                                       size_t control_interval_count) {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 2.0, 1.0, std::numbers::pi);
+  path.wpt_constraint(0, trajopt::LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.wpt_constraint(1, trajopt::LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.set_control_interval_counts({control_interval_count});
+  path.set_transcription_method(method);
+  return path;
+}
+
+/// Returns a differential path that drives two meters while stepping one
+/// meter sideways.
+trajopt::DifferentialPathBuilder differential_path(
+    trajopt::TranscriptionMethod method, size_t control_interval_count) {
+  trajopt::DifferentialPathBuilder path;
+  path.set_drivetrain(test_differential_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 2.0, 1.0, 0.0);
+  path.wpt_constraint(0, trajopt::LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.wpt_constraint(1, trajopt::LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.set_control_interval_counts({control_interval_count});
+  path.set_transcription_method(method);
+  return path;
+}
+
+/// Returns a trajectory's position at a time, interpolated linearly between
+/// samples.
+template <typename Trajectory>
+trajopt::Translation2d position_at(const Trajectory& trajectory,
+                                   double time) {
+  const auto& samples = trajectory.samples;
+  auto next = std::ranges::upper_bound(
+      samples, time, {}, [](const auto& sample) { return sample.timestamp; });
+  if (next == samples.begin()) {
+    return {samples.front().x, samples.front().y};
+  } else if (next == samples.end()) {
+    return {samples.back().x, samples.back().y};
+  }
+
+  const auto& previous = *std::prev(next);
+  double t =
+      (time - previous.timestamp) / (next->timestamp - previous.timestamp);
+  return {previous.x + t * (next->x - previous.x),
+          previous.y + t * (next->y - previous.y)};
+}
+
+/// Returns the largest distance between two trajectories' positions at the
+/// same time, over a common time grid spanning the shorter one.
+template <typename Trajectory>
+double max_position_error(const Trajectory& trajectory,
+                          const Trajectory& reference) {
+  constexpr size_t grid_size = 200;
+  double duration = std::min(trajectory.samples.back().timestamp,
+                             reference.samples.back().timestamp);
+
+  double error = 0.0;
+  for (size_t i = 0; i <= grid_size; ++i) {
+    double time = duration * static_cast<double>(i) / grid_size;
+    error = std::max(error, (position_at(trajectory, time) -
+                             position_at(reference, time))
+                                .norm());
+  }
+  return error;
+}
+
+/// Checks that each interval's displacement matches the trapezoidal rule on
+/// its end velocities to second order. Every scheme agrees with it up to a
+/// term bounded by the largest rate of change of the field-relative velocity
+/// over the interval times its duration squared.
+///
+/// @param x, y The sample positions.
+/// @param vx, vy The sample field-relative velocities.
+/// @param velocity_rate The largest rate of change of the field-relative
+///     velocity at each sample.
+/// @param dt The sample time steps.
+void check_kinematics(const std::vector<double>& x,
+                      const std::vector<double>& y,
+                      const std::vector<double>& vx,
+                      const std::vector<double>& vy,
+                      const std::vector<double>& velocity_rate,
+                      const std::vector<double>& dt) {
+  for (size_t k = 0; k + 1 < x.size(); ++k) {
+    CAPTURE(k);
+    double tolerance =
+        std::max(velocity_rate[k], velocity_rate[k + 1]) * dt[k] * dt[k] +
+        1e-6;
+    CHECK(std::abs(x[k + 1] - x[k] - 0.5 * (vx[k] + vx[k + 1]) * dt[k]) <=
+          tolerance);
+    CHECK(std::abs(y[k + 1] - y[k] - 0.5 * (vy[k] + vy[k + 1]) * dt[k]) <=
+          tolerance);
+  }
+}
+
+/// Benchmarks solving a path with each method, and reports each method's
+/// largest position error against a fine Hermite-Simpson solve, which stands
+/// in for the exact trajectory, on a common time grid.
+///
+/// @param drivetrain_name The drivetrain's name for labels.
+/// @param make_path Returns the path for a method and control interval count.
+template <typename Generator, typename Trajectory, typename MakePath>
+void benchmark_methods(std::string_view drivetrain_name, MakePath make_path) {
+  Generator reference_generator{
+      make_path(trajopt::TranscriptionMethod::HERMITE_SIMPSON, 200)};
+  auto reference_solution = reference_generator.generate();
+  REQUIRE(reference_solution.has_value());
+  Trajectory reference{*reference_solution};
+
+  for (const auto& [method, name] : methods) {
+    for (size_t control_interval_count : {10, 40}) {
+      auto label = std::string{drivetrain_name} + ", " + std::string{name} +
+                   ", " + std::to_string(control_interval_count) +
+                   " intervals";
+
+      Generator generator{make_path(method, control_interval_count)};
+      auto solution = generator.generate();
+      REQUIRE(solution.has_value());
+      Trajectory trajectory{*solution};
+      WARN(label << ": " << 1e3 * max_position_error(trajectory, reference)
+                 << " mm max position error, "
+                 << trajectory.samples.back().timestamp -
+                        reference.samples.back().timestamp
+                 << " s total time error");
+
+      BENCHMARK(label) {
+        Generator generator{make_path(method, control_interval_count)};
+        return generator.generate();
+      };
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("TranscriptionMethod - Sub-paths keep the method",
+          "[TranscriptionMethod]") {
+  auto path = swerve_path(trajopt::TranscriptionMethod::TRAPEZOIDAL, 10);
+  path.pose_wpt(2, 3.0, 0.0, 0.0);
+  path.set_control_interval_counts({10, 10});
+
+  CHECK(path.sub_path(1, 2).get_transcription_method() ==
+        trajopt::TranscriptionMethod::TRAPEZOIDAL);
+}
+
+TEST_CASE("TranscriptionMethod - Generators build every method",
+          "[TranscriptionMethod]") {
+  for (const auto& [method, name] : methods) {
+    for (bool eliminate_accelerations : {false, true}) {
+      INFO(name << (eliminate_accelerations ? ", reduced" : ""));
+
+      auto swerve = swerve_path(method, 5);
+      swerve.set_eliminate_accelerations(eliminate_accelerations);
+      CHECK_NOTHROW(trajopt::SwerveTrajectoryGenerator{std::move(swerve)});
+
+      trajopt::DifferentialPathBuilder differential_path;
+      differential_path.set_drivetrain(test_differential_drivetrain());
+      differential_path.pose_wpt(0, 0.0, 0.0, 0.0);
+      differential_path.pose_wpt(1, 2.0, 0.0, 0.0);
+      differential_path.set_control_interval_counts({5});
+      differential_path.set_transcription_method(method);
+      differential_path.set_eliminate_accelerations(eliminate_accelerations);
+      CHECK_NOTHROW(trajopt::DifferentialTrajectoryGenerator{
+          std::move(differential_path)});
+    }
+  }
+}
+
+TEST_CASE("TranscriptionMethod - Swerve solutions are accurate",
+          "[TranscriptionMethod]") {
+  using trajopt::SwerveTrajectory;
+  using trajopt::SwerveTrajectoryGenerator;
+
+  // A fine Hermite-Simpson solve stands in for the exact trajectory
+  SwerveTrajectoryGenerator reference_generator{
+      swerve_path(trajopt::TranscriptionMethod::HERMITE_SIMPSON, 200)};
+  auto reference_solution = reference_generator.generate();
+  REQUIRE(reference_solution.has_value());
+  SwerveTrajectory reference{*reference_solution};
+
+  for (const auto& [method, name] : methods) {
+    INFO(name);
+
+    SwerveTrajectoryGenerator generator{swerve_path(method, 40)};
+    auto solution = generator.generate();
+    REQUIRE(solution.has_value());
+
+    std::vector<double> acceleration;
+    for (size_t k = 0; k < solution->ax.size(); ++k) {
+      acceleration.push_back(std::hypot(solution->ax[k], solution->ay[k]));
+    }
+    check_kinematics(solution->x, solution->y, solution->vx, solution->vy,
+                     acceleration, solution->dt);
+
+    SwerveTrajectory trajectory{*solution};
+    CHECK_THAT(trajectory.samples.back().timestamp,
+               WithinRel(reference.samples.back().timestamp, 0.1));
+    CHECK(max_position_error(trajectory, reference) < 0.15);
+  }
+}
+
+TEST_CASE("TranscriptionMethod - Differential solutions are accurate",
+          "[TranscriptionMethod]") {
+  using trajopt::DifferentialTrajectory;
+  using trajopt::DifferentialTrajectoryGenerator;
+
+  // A fine Hermite-Simpson solve stands in for the exact trajectory
+  DifferentialTrajectoryGenerator reference_generator{
+      differential_path(trajopt::TranscriptionMethod::HERMITE_SIMPSON, 200)};
+  auto reference_solution = reference_generator.generate();
+  REQUIRE(reference_solution.has_value());
+  DifferentialTrajectory reference{*reference_solution};
+
+  for (const auto& [method, name] : methods) {
+    INFO(name);
+
+    DifferentialTrajectoryGenerator generator{differential_path(method, 40)};
+    auto solution = generator.generate();
+    REQUIRE(solution.has_value());
+
+    // The field-relative velocity changes with the wheel accelerations and,
+    // as the robot turns, with the heading
+    std::vector<double> vx;
+    std::vector<double> vy;
+    std::vector<double> velocity_rate;
+    for (size_t k = 0; k < solution->x.size(); ++k) {
+      double v = 0.5 * (solution->vl[k] + solution->vr[k]);
+      double a = 0.5 * (solution->al[k] + solution->ar[k]);
+      vx.push_back(v * std::cos(solution->heading[k]));
+      vy.push_back(v * std::sin(solution->heading[k]));
+      velocity_rate.push_back(std::abs(a) +
+                              std::abs(v * solution->angular_velocity[k]));
+    }
+    check_kinematics(solution->x, solution->y, vx, vy, velocity_rate,
+                     solution->dt);
+
+    DifferentialTrajectory trajectory{*solution};
+    CHECK_THAT(trajectory.samples.back().timestamp,
+               WithinRel(reference.samples.back().timestamp, 0.1));
+    CHECK(max_position_error(trajectory, reference) < 0.15);
+  }
+}
+
+TEST_CASE("TranscriptionMethod - Solve time and error",
+          "[.][benchmark][TranscriptionMethod]") {
+  benchmark_methods<trajopt::SwerveTrajectoryGenerator,
+                    trajopt::SwerveTrajectory>("Swerve", swerve_path);
+  benchmark_methods<trajopt::DifferentialTrajectoryGenerator,
+                    trajopt::DifferentialTrajectory>("Differential",
+                                                     differential_path);
+}
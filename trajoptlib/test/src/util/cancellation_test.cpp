@@ -0,0 +1,34 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/util/cancellation.hpp>
+
+TEST_CASE("CancellationToken - Cancel is per token", "[Cancellation]") {
+  trajopt::CancellationToken token1;
+  trajopt::CancellationToken token2;
+  auto token1_copy = token1;
+
+  CHECK_FALSE(token1.is_cancelled());
+  CHECK_FALSE(token2.is_cancelled());
+
+  token1.cancel();
+  CHECK(token1.is_cancelled());
+  CHECK(token1_copy.is_cancelled());
+  CHECK_FALSE(token2.is_cancelled());
+
+  token1.reset();
+  CHECK_FALSE(token1_copy.is_cancelled());
+}
+
+TEST_CASE("CancellationToken - cancel_all()", "[Cancellation]") {
+  trajopt::CancellationToken before;
+
+  trajopt::cancel_all();
+
+  trajopt::CancellationToken after;
+  CHECK(before.is_cancelled());
+  CHECK_FALSE(after.is_cancelled());
+
+  before.reset();
+  CHECK_FALSE(before.is_cancelled());
+}
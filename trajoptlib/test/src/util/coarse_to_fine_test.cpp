@@ -0,0 +1,36 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/coarse_to_fine.hpp>
+
+TEST_CASE("coarse_control_interval_counts() - Fraction of each segment",
+          "[CoarseToFine]") {
+  trajopt::SwervePathBuilder path;
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 0.0, 0.0);
+  path.pose_wpt(3, 3.0, 0.0, 0.0);
+  path.set_control_interval_counts({40, 0, 10});
+
+  CHECK(trajopt::coarse_control_interval_counts(path, 0.25) ==
+        std::vector<size_t>{10, 0, 3});
+  CHECK(trajopt::coarse_control_interval_counts(path, 0.01) ==
+        std::vector<size_t>{1, 0, 1});
+}
+
+TEST_CASE("coarse_control_interval_counts() - Keeps guess points",
+          "[CoarseToFine]") {
+  trajopt::SwervePathBuilder path;
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.sgmt_initial_guess_points(
+      0, {trajopt::Pose2d{0.5, 1.0, 0.0}, trajopt::Pose2d{1.0, 1.0, 0.0}});
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.set_control_interval_counts({20});
+
+  // Two segment guess points plus the waypoint need three intervals
+  CHECK(trajopt::coarse_control_interval_counts(path, 0.05) ==
+        std::vector<size_t>{3});
+}
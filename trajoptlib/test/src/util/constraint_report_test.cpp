@@ -0,0 +1,187 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/constraint/constraint.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/constraint_report.hpp>
+#include <trajopt/util/segment_layout.hpp>
+
+#include "test_drivetrains.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("ConstraintReport - Residuals", "[ConstraintReport]") {
+  using namespace trajopt;
+
+  auto residual = [](const Constraint& constraint, const Pose2d& pose,
+                     const Translation2d& velocity = {}) {
+    return constraint_residual(constraint, pose, velocity, 0.0, {}, 0.0);
+  };
+
+  // Inequalities are negative with slack and positive when violated
+  Constraint max_velocity = LinearVelocityMaxMagnitudeConstraint{2.0};
+  CHECK_THAT(residual(max_velocity, {}, {1.0, 0.0}), WithinAbs(-3.0, 1e-9));
+  CHECK_THAT(residual(max_velocity, {}, {3.0, 0.0}), WithinAbs(5.0, 1e-9));
+
+  Constraint keep_in = KeepInPolygonConstraint{
+      {{0.0, 0.0}, {4.0, 0.0}, {4.0, 4.0}, {0.0, 4.0}}};
+  CHECK_THAT(residual(keep_in, {1.0, 2.0, 0.0}), WithinAbs(-1.0, 1e-9));
+  CHECK_THAT(residual(keep_in, {5.0, 2.0, 0.0}), WithinAbs(1.0, 1e-9));
+
+  Constraint keep_out =
+      KeepOutPolygonConstraint{{{0.0, 0.0}}, {{0.0, 0.0}}, 1.0};
+  CHECK_THAT(residual(keep_out, {3.0, 0.0, 0.0}), WithinAbs(-2.0, 1e-9));
+
+  Constraint lane = LaneConstraint{{0.0, 0.0}, {4.0, 0.0}, 1.0};
+  CHECK(residual(lane, {2.0, 0.5, 0.0}) < 0.0);
+  CHECK(residual(lane, {2.0, -1.5, 0.0}) > 0.0);
+
+  // Equalities are the absolute error
+  Constraint pose = PoseEqualityConstraint{1.0, 2.0, 0.0};
+  CHECK_THAT(residual(pose, {1.0, 2.0, 0.0}), WithinAbs(0.0, 1e-9));
+  CHECK_THAT(residual(pose, {1.0, 1.5, 0.0}), WithinAbs(0.5, 1e-9));
+
+  // User constraints without residual() can't be evaluated
+  struct UserConstraint {
+    void apply([[maybe_unused]] slp::Problem<double>& problem,
+               [[maybe_unused]] const Pose2v<double>& pose,
+               [[maybe_unused]] const Translation2v<double>& v,
+               [[maybe_unused]] const slp::Variable<double>& ω,
+               [[maybe_unused]] const Translation2v<double>& a,
+               [[maybe_unused]] const slp::Variable<double>& α) {}
+  };
+  CHECK(std::isnan(residual(AnyConstraint{UserConstraint{}}, {})));
+}
+
+TEST_CASE("ConstraintReport - Rows", "[ConstraintReport]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path_builder;
+  path_builder.pose_wpt(0, 0.0, 0.0, 0.0);
+  path_builder.translation_wpt(1, 2.0, 0.0);
+  path_builder.sgmt_constraint(0, 1, LinearVelocityMaxMagnitudeConstraint{1.0});
+  const auto& path = path_builder.get_path();
+
+  // The robot drives along the x axis at 1 m/s, reaching the velocity limit in
+  // the middle sample
+  SegmentLayout layout{{2}};
+  std::vector<SampleState> states{
+      {.pose = {0.0, 0.0, 0.0}},
+      {.pose = {1.0, 0.0, 0.0}, .linear_velocity = {1.0, 0.0}},
+      {.pose = {2.0, 0.0, 0.0}}};
+
+  auto report = evaluate_constraints(path, layout, states, 1e-6);
+
+  // One row per waypoint constraint, plus one per segment sample
+  size_t wpt_constraint_count = path.waypoints[0].waypoint_constraints.size() +
+                                path.waypoints[1].waypoint_constraints.size();
+  size_t sgmt_constraint_count = path.waypoints[1].segment_constraints.size();
+  REQUIRE(report.size() == wpt_constraint_count + 2 * sgmt_constraint_count);
+  CHECK(report.wpt_index.size() == report.size());
+  CHECK(report.active.size() == report.size());
+
+  // sgmt_constraint() also adds the constraint to both waypoints, so only
+  // check the segment rows
+  size_t velocity_type =
+      Constraint{LinearVelocityMaxMagnitudeConstraint{1.0}}.index();
+  for (size_t row = 0; row < report.size(); ++row) {
+    if (report.type[row] != velocity_type || !report.segment_constraint[row]) {
+      continue;
+    }
+    CHECK(report.wpt_index[row] == 1);
+    if (report.sample[row] == 0) {
+      CHECK_THAT(report.residual[row], WithinAbs(-1.0, 1e-9));
+      CHECK_FALSE(report.active[row]);
+    } else {
+      CHECK(report.sample[row] == 1);
+      CHECK_THAT(report.residual[row], WithinAbs(0.0, 1e-9));
+      CHECK(report.active[row]);
+    }
+  }
+}
+
+TEST_CASE("ConstraintReport - Apply timing", "[ConstraintReport]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path_builder;
+  path_builder.set_drivetrain(test_swerve_drivetrain());
+  path_builder.pose_wpt(0, 0.0, 0.0, 0.0);
+  path_builder.pose_wpt(1, 2.0, 0.0, 0.0);
+  path_builder.sgmt_constraint(0, 1, LinearVelocityMaxMagnitudeConstraint{1.0});
+  path_builder.set_control_interval_counts({5});
+
+  SwerveTrajectoryGenerator generator{path_builder};
+  auto report = generator.constraint_report();
+
+  // Rows cover the constraints as given, but constraints others imply weren't
+  // applied, and none were deferred
+  for (size_t type = 0; type < constraint_type_names.size(); ++type) {
+    CHECK(report.timing.apply_count[type] <=
+          static_cast<size_t>(std::ranges::count(report.type, type)));
+  }
+
+  size_t pose_type = Constraint{PoseEqualityConstraint{0.0, 0.0, 0.0}}.index();
+  CHECK(report.timing.apply_count[pose_type] == 2);
+  CHECK(constraint_type_names[pose_type] == "PoseEqualityConstraint");
+}
+
+TEST_CASE("ConstraintReport - Constraints as given", "[ConstraintReport]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path_builder;
+  path_builder.set_drivetrain(test_swerve_drivetrain());
+  path_builder.pose_wpt(0, 0.0, 0.0, 0.0);
+  path_builder.pose_wpt(1, 2.0, 0.0, 0.0);
+  path_builder.wpt_constraint(1, LinearVelocityMaxMagnitudeConstraint{1.0});
+  path_builder.wpt_constraint(1, LinearVelocityMaxMagnitudeConstraint{2.0});
+  path_builder.set_control_interval_counts({5});
+
+  SwerveTrajectoryGenerator generator{path_builder};
+  auto report = generator.constraint_report();
+
+  // The looser velocity limit isn't applied, but it's still reported
+  size_t velocity_type =
+      Constraint{LinearVelocityMaxMagnitudeConstraint{1.0}}.index();
+  CHECK(std::ranges::count(report.type, velocity_type) == 2);
+  CHECK(report.timing.apply_count[velocity_type] == 1);
+  CHECK(report.size() == 4);
+}
+
+TEST_CASE("ConstraintReport - Removed constraint count", "[ConstraintReport]") {
+  using namespace trajopt;
+
+  // sgmt_constraint() adds each constraint to both waypoints and the segment.
+  // Of the nine copies, the looser limits and the duplicates are implied by
+  // the first limit, and so is the last waypoint's copy, since the segment's
+  // constraints cover its sample. Two remain.
+  auto add_constraints = [](auto& path_builder) {
+    path_builder.pose_wpt(0, 0.0, 0.0, 0.0);
+    path_builder.pose_wpt(1, 2.0, 0.0, 0.0);
+    path_builder.sgmt_constraint(0, 1,
+                                 LinearVelocityMaxMagnitudeConstraint{1.0});
+    path_builder.sgmt_constraint(0, 1,
+                                 LinearVelocityMaxMagnitudeConstraint{2.0});
+    path_builder.sgmt_constraint(0, 1,
+                                 LinearVelocityMaxMagnitudeConstraint{1.0});
+    path_builder.set_control_interval_counts({5});
+  };
+
+  SwervePathBuilder swerve_path;
+  swerve_path.set_drivetrain(test_swerve_drivetrain());
+  add_constraints(swerve_path);
+  SwerveTrajectoryGenerator swerve_generator{swerve_path};
+  CHECK(swerve_generator.constraint_report().removed_constraint_count == 7);
+
+  DifferentialPathBuilder differential_path;
+  differential_path.set_drivetrain(test_differential_drivetrain());
+  add_constraints(differential_path);
+  DifferentialTrajectoryGenerator differential_generator{differential_path};
+  CHECK(differential_generator.constraint_report().removed_constraint_count ==
+        7);
+}
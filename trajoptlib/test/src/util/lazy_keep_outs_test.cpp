@@ -0,0 +1,134 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <sleipnir/optimization/problem.hpp>
+#include <trajopt/constraint/keep_out_polygon_constraint.hpp>
+#include <trajopt/solve_options.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/lazy_keep_outs.hpp>
+
+#include "test_drivetrains.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+/// A one-variable problem that minimizes x² from x = 3 with a keep-out
+/// x ≥ bound, whose clearance is x - bound.
+struct KeepOutProblem {
+  slp::Problem<double> problem;
+  slp::Variable<double> x = problem.decision_variable();
+  double bound;
+  bool active = false;
+
+  /// Activation distances passed to activate(), in order
+  std::vector<double> activation_distances;
+
+  explicit KeepOutProblem(double bound) : bound{bound} {
+    x.set_value(3.0);
+    problem.minimize(x * x);
+  }
+
+  size_t activate(double activation_distance) {
+    activation_distances.push_back(activation_distance);
+    if (active || x.value() - bound >= activation_distance) {
+      return 0;
+    }
+    problem.subject_to(x >= bound);
+    active = true;
+    return 1;
+  }
+
+  slp::ExitStatus solve(const trajopt::SolveOptions& options) {
+    return trajopt::solve_with_lazy_keep_outs(
+        problem, options,
+        [&](double distance) { return activate(distance); });
+  }
+};
+
+trajopt::SolveOptions lazy_options() {
+  trajopt::SolveOptions options;
+  options.lazy_keep_outs = true;
+  return options;
+}
+
+}  // namespace
+
+TEST_CASE("Lazy keep-outs - Distant keep-out stays inactive",
+          "[LazyKeepOuts]") {
+  KeepOutProblem lazy{-5.0};
+  CHECK(lazy.solve(lazy_options()) == slp::ExitStatus::SUCCESS);
+
+  // Checked before the only solve and after it
+  CHECK(lazy.activation_distances ==
+        std::vector{lazy_options().keep_out_activation_distance, 0.0});
+  CHECK_FALSE(lazy.active);
+
+  KeepOutProblem eager{-5.0};
+  CHECK(eager.solve({}) == slp::ExitStatus::SUCCESS);
+  CHECK(eager.activation_distances ==
+        std::vector{std::numeric_limits<double>::infinity()});
+  CHECK(eager.active);
+
+  CHECK_THAT(lazy.x.value(), WithinAbs(eager.x.value(), 1e-6));
+}
+
+TEST_CASE("Lazy keep-outs - Violated keep-out is activated and re-solved",
+          "[LazyKeepOuts]") {
+  // The initial guess clears the keep-out, but the unconstrained optimum at
+  // x = 0 violates it
+  KeepOutProblem lazy{1.0};
+  CHECK(lazy.solve(lazy_options()) == slp::ExitStatus::SUCCESS);
+
+  // Inactive before the first solve, activated after it, and satisfied after
+  // the re-solve
+  CHECK(lazy.activation_distances ==
+        std::vector{lazy_options().keep_out_activation_distance, 0.0, 0.0});
+  CHECK(lazy.active);
+  CHECK_THAT(lazy.x.value(), WithinAbs(1.0, 1e-6));
+
+  KeepOutProblem eager{1.0};
+  CHECK(eager.solve({}) == slp::ExitStatus::SUCCESS);
+  CHECK_THAT(lazy.x.value(), WithinAbs(eager.x.value(), 1e-6));
+}
+
+TEST_CASE("Lazy keep-outs - Same trajectory as eager keep-outs",
+          "[LazyKeepOuts]") {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.set_bumpers(0.65, 0.65, 0.65, 0.65);
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 4.0, 0.0, 0.0);
+  path.set_control_interval_counts({20});
+
+  // One obstacle on the straight-line initial guess and one far from it
+  for (auto [x, y] : {std::pair{2.0, 0.1}, std::pair{2.0, 5.0}}) {
+    for (const auto& bumper : path.get_bumpers()) {
+      path.sgmt_constraint(0, 1,
+                           trajopt::KeepOutPolygonConstraint{
+                               bumper.points, {{x, y}}, 0.3});
+    }
+  }
+
+  trajopt::SwerveTrajectoryGenerator eager_generator{path};
+  auto eager_solution = eager_generator.generate();
+  REQUIRE(eager_solution.has_value());
+
+  trajopt::SwerveTrajectoryGenerator lazy_generator{path};
+  auto lazy_solution = lazy_generator.generate(lazy_options());
+  REQUIRE(lazy_solution.has_value());
+
+  REQUIRE(lazy_solution->x.size() == eager_solution->x.size());
+  for (size_t sample = 0; sample < eager_solution->x.size(); ++sample) {
+    CHECK_THAT(lazy_solution->x[sample],
+               WithinAbs(eager_solution->x[sample], 1e-3));
+    CHECK_THAT(lazy_solution->y[sample],
+               WithinAbs(eager_solution->y[sample], 1e-3));
+  }
+}
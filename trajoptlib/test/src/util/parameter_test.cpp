@@ -0,0 +1,99 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/parameter.hpp>
+
+#include "test_drivetrains.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+/// A user constraint on the robot's speed, with a parametric limit.
+struct MaxSpeedConstraint {
+  trajopt::Parameter max_speed;
+
+  void apply(slp::Problem<double>& problem,
+             [[maybe_unused]] const trajopt::Pose2v<double>& pose,
+             const trajopt::Translation2v<double>& v,
+             [[maybe_unused]] const slp::Variable<double>& ω,
+             [[maybe_unused]] const trajopt::Translation2v<double>& a,
+             [[maybe_unused]] const slp::Variable<double>& α) {
+    problem.subject_to(v.x() * v.x() + v.y() * v.y() <=
+                       max_speed.variable() * max_speed.variable());
+  }
+};
+
+trajopt::SwervePathBuilder max_speed_path(const trajopt::Parameter& max_speed) {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 4.0, 1.0, 0.0);
+  path.sgmt_constraint(0, 1, MaxSpeedConstraint{max_speed});
+  path.set_control_interval_counts({20});
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("Parameter - Copies share the value", "[Parameter]") {
+  trajopt::Parameter parameter{1.0};
+  auto copy = parameter;
+  trajopt::Parameter other{1.0};
+
+  CHECK(copy == parameter);
+  CHECK_FALSE(other == parameter);
+
+  parameter.set_value(2.0);
+  CHECK(copy.value() == 2.0);
+  CHECK(other.value() == 1.0);
+
+  // Expressions built from the parameter see the new value
+  auto expression = copy.variable() * 3.0;
+  copy.set_value(4.0);
+  CHECK(parameter.value() == 4.0);
+  CHECK(expression.value() == 12.0);
+}
+
+TEST_CASE("Parameter - Re-solve after a change", "[Parameter]") {
+  trajopt::Parameter max_speed{2.0};
+  trajopt::SwerveTrajectoryGenerator generator{max_speed_path(max_speed)};
+  auto fast_solution = generator.generate();
+  REQUIRE(fast_solution.has_value());
+
+  max_speed.set_value(1.0);
+  auto slow_solution = generator.resolve();
+  REQUIRE(slow_solution.has_value());
+
+  // The re-solve honors the new limit and finds the same optimum as a problem
+  // built with it
+  trajopt::SwerveTrajectoryGenerator fresh_generator{
+      max_speed_path(trajopt::Parameter{1.0})};
+  auto fresh_solution = fresh_generator.generate();
+  REQUIRE(fresh_solution.has_value());
+
+  auto total_time = [](const trajopt::SwerveSolution& solution) {
+    return std::accumulate(solution.dt.begin(), solution.dt.end(), 0.0);
+  };
+  CHECK(total_time(*slow_solution) > total_time(*fast_solution));
+  CHECK_THAT(total_time(*slow_solution),
+             WithinAbs(total_time(*fresh_solution), 1e-3));
+
+  REQUIRE(slow_solution->x.size() == fresh_solution->x.size());
+  for (size_t sample = 0; sample < fresh_solution->x.size(); ++sample) {
+    CHECK(std::hypot(slow_solution->vx[sample], slow_solution->vy[sample]) <=
+          1.0 + 1e-6);
+    CHECK_THAT(slow_solution->x[sample],
+               WithinAbs(fresh_solution->x[sample], 1e-3));
+    CHECK_THAT(slow_solution->y[sample],
+               WithinAbs(fresh_solution->y[sample], 1e-3));
+  }
+}
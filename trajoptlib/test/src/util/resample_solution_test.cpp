@@ -0,0 +1,96 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/resample_solution.hpp>
+#include <trajopt/util/segment_layout.hpp>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("resample_solution() - Swerve constant acceleration",
+          "[ResampleSolution]") {
+  // x = 1/2t², θ = 1/4t²
+  trajopt::SwerveSolution solution;
+  for (size_t index = 0; index < 5; ++index) {
+    double t = 0.5 * index;
+    solution.dt.push_back(0.5);
+    solution.x.push_back(0.5 * t * t);
+    solution.y.push_back(0.0);
+    solution.thetacos.push_back(std::cos(0.25 * t * t));
+    solution.thetasin.push_back(std::sin(0.25 * t * t));
+    solution.vx.push_back(t);
+    solution.vy.push_back(0.0);
+    solution.omega.push_back(0.5 * t);
+    solution.ax.push_back(1.0);
+    solution.ay.push_back(0.0);
+    solution.alpha.push_back(0.5);
+  }
+
+  solution.module_fx = {{0.0}, {1.0}, {2.0}, {3.0}, {4.0}};
+  solution.module_fy = {{0.0}, {0.0}, {0.0}, {0.0}, {0.0}};
+
+  auto result = trajopt::resample_solution(
+      solution, trajopt::SegmentLayout{{4}}, trajopt::SegmentLayout{{8}});
+
+  REQUIRE(result.x.size() == 9);
+  REQUIRE(result.module_fx.sample_count() == 9);
+  for (size_t index = 0; index < 9; ++index) {
+    double t = 0.25 * index;
+    CHECK_THAT(result.dt[index], WithinAbs(0.25, 1e-9));
+    CHECK_THAT(result.x[index], WithinAbs(0.5 * t * t, 1e-9));
+    CHECK_THAT(result.vx[index], WithinAbs(t, 1e-9));
+    CHECK_THAT(result.thetacos[index], WithinAbs(std::cos(0.25 * t * t), 1e-9));
+    CHECK_THAT(result.thetasin[index], WithinAbs(std::sin(0.25 * t * t), 1e-9));
+    CHECK_THAT(result.omega[index], WithinAbs(0.5 * t, 1e-9));
+  }
+  CHECK(result.module_fx[1][0] == 0.0);
+  CHECK(result.module_fx[2][0] == 1.0);
+  CHECK(result.module_fx[8][0] == 4.0);
+}
+
+TEST_CASE("resample_solution() - Differential keeps waypoints",
+          "[ResampleSolution]") {
+  trajopt::DifferentialSolution solution{
+      .dt = {0.5, 0.5, 1.0, 1.0},
+      .x = {0.0, 1.0, 2.0, 4.0},
+      .y = {0.0, 0.0, 0.5, 1.0},
+      .heading = {0.0, 0.1, 0.2, 0.3},
+      .vl = {0.0, 1.0, 2.0, 0.0},
+      .vr = {0.0, 1.5, 2.0, 0.0},
+      .angular_velocity = {0.0, 0.5, 0.0, 0.0},
+      .al = {2.0, 2.0, -2.0, 0.0},
+      .ar = {3.0, 1.0, -2.0, 0.0},
+      .angular_acceleration = {1.0, -1.0, 0.0, 0.0},
+      .Fl = {1.0, 2.0, 3.0, 4.0},
+      .Fr = {1.0, 2.0, 3.0, 4.0}};
+
+  auto result =
+      trajopt::resample_solution(solution, trajopt::SegmentLayout{{2, 1}},
+                                 trajopt::SegmentLayout{{4, 2}});
+
+  REQUIRE(result.x.size() == 7);
+
+  // Waypoint samples are copied exactly
+  for (auto [from, to] : {std::pair{0, 0}, std::pair{2, 4}, std::pair{3, 6}}) {
+    CHECK(result.x[to] == solution.x[from]);
+    CHECK(result.y[to] == solution.y[from]);
+    CHECK(result.heading[to] == solution.heading[from]);
+    CHECK(result.vl[to] == solution.vl[from]);
+    CHECK(result.Fr[to] == solution.Fr[from]);
+  }
+
+  // Segment durations are preserved
+  CHECK_THAT(result.dt[0] + result.dt[1] + result.dt[2] + result.dt[3],
+             WithinAbs(1.0, 1e-9));
+  CHECK_THAT(result.dt[4] + result.dt[5], WithinAbs(1.0, 1e-9));
+
+  // Interior samples interpolate between their source samples
+  CHECK_THAT(result.x[2], WithinAbs(solution.x[1], 1e-9));
+  CHECK_THAT(result.Fl[1], WithinAbs(1.5, 1e-9));
+  CHECK_THAT(result.vl[5], WithinAbs(1.0, 1e-9));
+}
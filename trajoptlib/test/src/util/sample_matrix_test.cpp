@@ -0,0 +1,33 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/util/sample_matrix.hpp>
+
+TEST_CASE("SampleMatrix - Sample-major storage", "[SampleMatrix]") {
+  trajopt::SampleMatrix<double> matrix{{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+
+  CHECK(matrix.sample_count() == 3);
+  CHECK(matrix.column_count() == 2);
+  CHECK(matrix[1][0] == 3.0);
+  CHECK(matrix[2][1] == 6.0);
+  CHECK(matrix[1].size() == 2);
+
+  std::vector<double> values(matrix.values().begin(), matrix.values().end());
+  CHECK(values == std::vector{1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+
+  matrix[0][1] = 7.0;
+  CHECK(matrix.values()[1] == 7.0);
+}
+
+TEST_CASE("SampleMatrix - Resize", "[SampleMatrix]") {
+  trajopt::SampleMatrix<double> matrix;
+  CHECK(matrix.empty());
+
+  matrix.resize(4, 3);
+  CHECK(matrix.sample_count() == 4);
+  CHECK(matrix.column_count() == 3);
+  CHECK(matrix.values().size() == 12);
+  CHECK(matrix == trajopt::SampleMatrix<double>(4, 3));
+}
@@ -0,0 +1,43 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/util/segment_layout.hpp>
+#include <trajopt/util/trajopt_util.hpp>
+
+TEST_CASE("SegmentLayout - Offsets", "[SegmentLayout]") {
+  trajopt::SegmentLayout layout{{2, 3}};
+
+  CHECK(layout.segment_count() == 2);
+  CHECK(layout.waypoint_count() == 3);
+  CHECK(layout.sample_count() == 6);
+
+  CHECK(layout.interval_count(0) == 2);
+  CHECK(layout.interval_count(1) == 3);
+
+  CHECK(layout.start(0) == 0);
+  CHECK(layout.end(0) == 2);
+  CHECK(layout.start(1) == 2);
+  CHECK(layout.end(1) == 5);
+}
+
+TEST_CASE("SegmentLayout - Matches get_index()", "[SegmentLayout]") {
+  std::vector<size_t> Ns{4, 0, 7, 1};
+  trajopt::SegmentLayout layout{Ns};
+
+  for (size_t wpt_index = 0; wpt_index <= Ns.size(); ++wpt_index) {
+    for (size_t sample_index = 0; sample_index < 3; ++sample_index) {
+      CHECK(layout.index(wpt_index, sample_index) ==
+            trajopt::get_index(Ns, wpt_index, sample_index));
+    }
+  }
+}
+
+TEST_CASE("SegmentLayout - Empty", "[SegmentLayout]") {
+  trajopt::SegmentLayout layout;
+
+  CHECK(layout.segment_count() == 0);
+  CHECK(layout.waypoint_count() == 1);
+  CHECK(layout.sample_count() == 1);
+}
@@ -0,0 +1,65 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <variant>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/simplify_constraints.hpp>
+
+TEST_CASE("simplify_constraints() - Duplicates and dominated bounds",
+          "[SimplifyConstraints]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 0.0, 0.0);
+  path.set_control_interval_counts({5, 5});
+
+  path.wpt_constraint(1, LinearVelocityMaxMagnitudeConstraint{2.0});
+  path.wpt_constraint(1, LinearVelocityMaxMagnitudeConstraint{1.0});
+  path.wpt_constraint(1, PointAtConstraint{{3.0, 0.0}, 0.1});
+  path.wpt_constraint(1, PointAtConstraint{{3.0, 0.0}, 0.2});
+  path.wpt_constraint(1, PointAtConstraint{{3.0, 0.0}, 0.2, true});
+  path.wpt_constraint(1, TranslationEqualityConstraint{1.0, 0.0});
+  path.wpt_constraint(1, TranslationEqualityConstraint{1.0, 0.0});
+
+  auto simplified = path.get_path();
+  CHECK(simplify_constraints(simplified, path.get_control_interval_counts()) ==
+        3);
+
+  const auto& constraints = simplified.waypoints[1].waypoint_constraints;
+  REQUIRE(constraints.size() == 5);
+  CHECK(std::get<LinearVelocityMaxMagnitudeConstraint>(constraints[1])
+            .max_magnitude() == 1.0);
+  CHECK(std::get<PointAtConstraint>(constraints[2]).heading_tolerance() ==
+        0.1);
+  CHECK(std::get<PointAtConstraint>(constraints[3]).flip());
+}
+
+TEST_CASE("simplify_constraints() - Segment covers its starting waypoint",
+          "[SimplifyConstraints]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 0.0, 0.0);
+  path.pose_wpt(3, 3.0, 0.0, 0.0);
+  path.set_control_interval_counts({5, 0, 5});
+  path.sgmt_constraint(0, 3, LinearVelocityMaxMagnitudeConstraint{1.0});
+
+  auto simplified = path.get_path();
+  CHECK(simplify_constraints(simplified, path.get_control_interval_counts()) ==
+        2);
+
+  // Waypoints 0 and 2 start nonempty segments. Waypoint 1 starts an empty
+  // segment and waypoint 3 ends the path, so they keep their copies.
+  CHECK(simplified.waypoints[0].waypoint_constraints.size() == 1);
+  CHECK(simplified.waypoints[1].waypoint_constraints.size() == 2);
+  CHECK(simplified.waypoints[2].waypoint_constraints.size() == 1);
+  CHECK(simplified.waypoints[3].waypoint_constraints.size() == 2);
+  for (size_t wpt_index = 1; wpt_index < 4; ++wpt_index) {
+    CHECK(simplified.waypoints[wpt_index].segment_constraints.size() == 1);
+  }
+}
@@ -0,0 +1,271 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/transcription_method.hpp>
+#include <trajopt/util/simplify_constraints.hpp>
+#include <trajopt/util/split_path.hpp>
+
+#include "test_drivetrains.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+/// A user constraint that does nothing.
+struct EmptyConstraint {
+  void apply([[maybe_unused]] slp::Problem<double>& problem,
+             [[maybe_unused]] const trajopt::Pose2v<double>& pose,
+             [[maybe_unused]] const trajopt::Translation2v<double>& v,
+             [[maybe_unused]] const slp::Variable<double>& ω,
+             [[maybe_unused]] const trajopt::Translation2v<double>& a,
+             [[maybe_unused]] const slp::Variable<double>& α) {}
+};
+
+}  // namespace
+
+TEST_CASE("find_split_waypoints() - Pinned stops", "[SplitPath]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 0.0, 0.0);
+  path.translation_wpt(3, 3.0, 0.0);
+  path.pose_wpt(4, 4.0, 0.0, 0.0);
+  path.set_control_interval_counts({5, 5, 5, 5});
+
+  for (size_t wpt_index : {1, 3, 4}) {
+    path.wpt_constraint(wpt_index, LinearVelocityMaxMagnitudeConstraint{0.0});
+    path.wpt_constraint(wpt_index, AngularVelocityMaxMagnitudeConstraint{0.0});
+  }
+  path.wpt_constraint(2, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.wpt_constraint(2, AngularVelocityMaxMagnitudeConstraint{1.0});
+
+  // Waypoint 2 can still turn, waypoint 3 has no fixed heading, and
+  // waypoint 4 is the path's end
+  CHECK(find_split_waypoints(path.get_path()) == std::vector<size_t>{1});
+}
+
+TEST_CASE("find_split_waypoints() - Stops before constrained segments",
+          "[SplitPath]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 0.0, 0.0);
+  path.wpt_constraint(1, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.wpt_constraint(1, AngularVelocityMaxMagnitudeConstraint{0.0});
+  path.sgmt_constraint(1, 2, AngularVelocityMaxMagnitudeConstraint{0.0});
+  path.set_control_interval_counts({5, 5});
+
+  // The following segment's constraint applies to the stop's sample, so
+  // simplification removes the stop's own copy. Generators look for stops in
+  // the path as given.
+  auto simplified = path.get_path();
+  simplify_constraints(simplified, path.get_control_interval_counts());
+  CHECK(find_split_waypoints(simplified).empty());
+  CHECK(find_split_waypoints(path.get_path()) == std::vector<size_t>{1});
+}
+
+TEST_CASE("PathBuilder - Sub-path", "[SplitPath]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.sgmt_initial_guess_points(0, {Pose2d{0.5, 1.0, 0.0}});
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.sgmt_initial_guess_points(1, {Pose2d{1.5, 1.0, 0.0}});
+  path.pose_wpt(2, 2.0, 0.0, 0.0);
+  path.sgmt_constraint(0, 2, LinearVelocityMaxMagnitudeConstraint{1.0});
+  path.set_control_interval_counts({4, 6});
+
+  auto sub_path = path.sub_path(1, 2);
+
+  CHECK(sub_path.get_control_interval_counts() == std::vector<size_t>{6});
+  REQUIRE(sub_path.get_path().waypoints.size() == 2);
+  CHECK(sub_path.get_path().waypoints[0].segment_constraints.empty());
+  CHECK(sub_path.get_path().waypoints[1].segment_constraints.size() == 1);
+
+  const auto& guess_points = sub_path.get_initial_guess_points();
+  REQUIRE(guess_points.size() == 2);
+  REQUIRE(guess_points[0].size() == 1);
+  CHECK(guess_points[0][0].x() == 1.0);
+  CHECK(guess_points[1].size() == 2);
+}
+
+TEST_CASE("join_solutions() - Shared waypoint sample", "[SplitPath]") {
+  trajopt::SwerveSolution first;
+  first.dt = {0.1, 0.1, 0.0};
+  first.x = {0.0, 0.5, 1.0};
+  first.module_fx = {{1.0}, {2.0}, {3.0}};
+  first.module_fy = {{0.0}, {0.0}, {0.0}};
+
+  trajopt::SwerveSolution second;
+  second.dt = {0.2, 0.2};
+  second.x = {1.0, 2.0};
+  second.module_fx = {{4.0}, {5.0}};
+  second.module_fy = {{0.0}, {0.0}};
+
+  auto joined = trajopt::join_solutions({first, second});
+
+  // The shared sample's time step comes from the second sub-path
+  CHECK(joined.dt == std::vector{0.1, 0.1, 0.2, 0.2});
+  CHECK(joined.x == std::vector{0.0, 0.5, 1.0, 2.0});
+  CHECK(joined.module_fx ==
+        trajopt::SampleMatrix<double>{{1.0}, {2.0}, {4.0}, {5.0}});
+}
+
+TEST_CASE("can_split_at_stops() - Transcription methods", "[SplitPath]") {
+  using trajopt::TranscriptionMethod;
+
+  CHECK(trajopt::can_split_at_stops(TranscriptionMethod::DEFAULT));
+  CHECK(trajopt::can_split_at_stops(TranscriptionMethod::EXPLICIT_EULER));
+  CHECK_FALSE(trajopt::can_split_at_stops(TranscriptionMethod::TRAPEZOIDAL));
+  CHECK_FALSE(
+      trajopt::can_split_at_stops(TranscriptionMethod::HERMITE_SIMPSON));
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Trapezoidal paths aren't split",
+          "[SplitPath]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 2.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 2.0, 1.0);
+  path.wpt_constraint(1, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.wpt_constraint(1, AngularVelocityMaxMagnitudeConstraint{0.0});
+  path.set_control_interval_counts({5, 5});
+  path.set_transcription_method(TranscriptionMethod::TRAPEZOIDAL);
+  REQUIRE(find_split_waypoints(path.get_path()) == std::vector<size_t>{1});
+
+  SwerveTrajectoryGenerator whole_generator{path};
+  auto whole = whole_generator.generate();
+  REQUIRE(whole.has_value());
+
+  SolveOptions options;
+  options.split_at_stops = true;
+  SwerveTrajectoryGenerator split_generator{path};
+  auto split = split_generator.generate(options);
+  REQUIRE(split.has_value());
+
+  // The interval before the stop uses the stop's acceleration, so the path is
+  // solved whole instead of joining sub-paths that disagree on it
+  REQUIRE(split->x.size() == whole->x.size());
+  for (size_t sample = 0; sample < whole->x.size(); ++sample) {
+    CHECK_THAT(split->dt[sample], WithinAbs(whole->dt[sample], 1e-6));
+    CHECK_THAT(split->x[sample], WithinAbs(whole->x[sample], 1e-6));
+    CHECK_THAT(split->ax[sample], WithinAbs(whole->ax[sample], 1e-6));
+  }
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Split solves seed the whole problem",
+          "[SplitPath]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 2.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 2.0, 1.0);
+  path.wpt_constraint(1, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.wpt_constraint(1, AngularVelocityMaxMagnitudeConstraint{0.0});
+  path.set_control_interval_counts({5, 5});
+
+  SolveOptions options;
+  options.split_at_stops = true;
+  SwerveTrajectoryGenerator generator{path};
+  auto split = generator.generate(options);
+  REQUIRE(split.has_value());
+
+  // A re-solve without iterations returns the iterate it starts from, which
+  // is the joined solution
+  SolveOptions no_iterations;
+  no_iterations.max_iterations = 0;
+  no_iterations.return_last_iterate_on_limit = true;
+  auto resolved = generator.resolve(no_iterations);
+  REQUIRE(resolved.has_value());
+  REQUIRE(resolved->x.size() == split->x.size());
+  for (size_t sample = 0; sample < split->x.size(); ++sample) {
+    CHECK_THAT(resolved->dt[sample], WithinAbs(split->dt[sample], 1e-6));
+    CHECK_THAT(resolved->x[sample], WithinAbs(split->x[sample], 1e-6));
+    CHECK_THAT(resolved->y[sample], WithinAbs(split->y[sample], 1e-6));
+  }
+}
+
+TEST_CASE("has_user_constraints() - Waypoint and segment constraints",
+          "[SplitPath]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.pose_wpt(2, 2.0, 0.0, 0.0);
+  path.set_control_interval_counts({5, 5});
+  CHECK_FALSE(has_user_constraints(path.get_path()));
+
+  auto with_waypoint_constraint = path;
+  with_waypoint_constraint.wpt_constraint(1, EmptyConstraint{});
+  CHECK(has_user_constraints(with_waypoint_constraint.get_path()));
+
+  auto with_segment_constraint = path;
+  with_segment_constraint.get_path().waypoints[2].segment_constraints.push_back(
+      EmptyConstraint{});
+  CHECK(has_user_constraints(with_segment_constraint.get_path()));
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Split paths with parameters",
+          "[SplitPath]") {
+  using namespace trajopt;
+
+  // The stop's pose and a point-at target spanning both sub-paths are
+  // parameters, which each sub-path gets its own copy of
+  PoseParameter stop{Pose2d{2.0, 0.0, 0.0}};
+  TranslationParameter target{Translation2d{6.0, 1.0}};
+
+  SwervePathBuilder path;
+  path.set_drivetrain(test_swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.wpt_constraint(1, PoseEqualityConstraint{stop});
+  path.pose_wpt(2, 2.0, 2.0, 1.0);
+  path.wpt_constraint(1, LinearVelocityMaxMagnitudeConstraint{0.0});
+  path.wpt_constraint(1, AngularVelocityMaxMagnitudeConstraint{0.0});
+  path.sgmt_constraint(0, 2, PointAtConstraint{target, 1.0});
+  path.set_control_interval_counts({5, 5});
+  REQUIRE(find_split_waypoints(path.get_path()) == std::vector<size_t>{1});
+
+  SwerveTrajectoryGenerator whole_generator{path};
+  auto whole = whole_generator.generate();
+  REQUIRE(whole.has_value());
+
+  SolveOptions options;
+  options.split_at_stops = true;
+  SwerveTrajectoryGenerator split_generator{path};
+  auto split = split_generator.generate(options);
+  REQUIRE(split.has_value());
+
+  REQUIRE(split->x.size() == whole->x.size());
+  for (size_t sample = 0; sample < whole->x.size(); ++sample) {
+    CHECK_THAT(split->x[sample], WithinAbs(whole->x[sample], 1e-6));
+    CHECK_THAT(split->y[sample], WithinAbs(whole->y[sample], 1e-6));
+  }
+
+  // Paths with user constraints are solved whole
+  auto user_path = path;
+  user_path.sgmt_constraint(0, 2, EmptyConstraint{});
+  SwerveTrajectoryGenerator user_generator{user_path};
+  auto user_split = user_generator.generate(options);
+  REQUIRE(user_split.has_value());
+  REQUIRE(user_split->x.size() == whole->x.size());
+  for (size_t sample = 0; sample < whole->x.size(); ++sample) {
+    CHECK_THAT(user_split->x[sample], WithinAbs(whole->x[sample], 1e-6));
+  }
+}